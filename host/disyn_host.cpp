@@ -0,0 +1,126 @@
+// Runs the firmware DSP task (src/dsp/DspTask.cpp) on the host: a control thread plays the UI
+// core's role, sending parameters through the intercore mailbox and toggling the gate, while the
+// main thread calls dsp::Tick() for each audio block. With DISYN_PIPELINED the main thread
+// calls dsp::FrontTick() instead and the back stage runs as its own task.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <thread>
+
+#include "AlgorithmInfo.h"
+#include "Config.h"
+#include "HostHal.h"
+#include "IntercoreQueue.h"
+#include "Parameters.h"
+#include "dsp/DspTask.h"
+
+namespace {
+
+constexpr int kBlockFrames = 64; // kAudioBlockSize in DspTask.cpp
+
+struct Options {
+    double seconds = 5.0;
+    int algorithm = -1;
+    bool realtime = false;
+};
+
+void printUsage(const char *program) {
+    std::cerr << "usage: " << program << " [--seconds S] [--algorithm N] [--realtime]\n";
+}
+
+bool parseOptions(int argc, char **argv, Options &options) {
+    for (int i = 1; i < argc; ++i) {
+        const bool hasValue = i + 1 < argc;
+        if (std::strcmp(argv[i], "--seconds") == 0 && hasValue) {
+            options.seconds = std::atof(argv[++i]);
+        } else if (std::strcmp(argv[i], "--algorithm") == 0 && hasValue) {
+            options.algorithm = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--realtime") == 0) {
+            options.realtime = true;
+        } else {
+            return false;
+        }
+    }
+    return options.seconds > 0.0;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    disyn::Parameters params;
+    if (options.algorithm >= 0) {
+        params.algorithm = static_cast<uint8_t>(options.algorithm);
+    }
+
+    // Written by whichever thread writes the audio output.
+    std::atomic<long> peakDeviation{0};
+    disyn::host::setAudioSink([&peakDeviation](const uint16_t *samples, size_t count) {
+        long peak = peakDeviation.load(std::memory_order_relaxed);
+        for (size_t i = 0; i < count; ++i) {
+            peak = std::max(peak, std::labs(static_cast<long>(samples[i]) - 0x8000));
+        }
+        peakDeviation.store(peak, std::memory_order_relaxed);
+    });
+    disyn::host::setRealtimeAudio(options.realtime);
+
+    disyn::dsp::Init();
+#if DISYN_PIPELINED
+    xTaskCreatePinnedToCore(disyn::dsp::BackTask, "DisynDSPBack", 8192, nullptr, 3, nullptr, 0);
+#endif
+
+    // Control thread: a note every 500 ms and a slow param1 sweep, sent at the UI's 10 ms rate.
+    std::atomic<bool> running{true};
+    std::thread control([&running, params]() mutable {
+        int tick = 0;
+        while (running.load()) {
+            disyn::host::setGateInput((tick / 25) % 2 == 0);
+            params.param1 = static_cast<float>(tick % 400) / 400.0f;
+            disyn::ParamMessage message{};
+            message.params = params;
+            disyn::gParamMailbox.publish(message);
+            ++tick;
+            vTaskDelay(pdMS_TO_TICKS(10));
+        }
+    });
+
+    const long blocks = static_cast<long>(options.seconds * kSampleRate / kBlockFrames);
+    double worstMicros = 0.0;
+    double totalMicros = 0.0;
+    for (long block = 0; block < blocks; ++block) {
+        const auto start = std::chrono::steady_clock::now();
+#if DISYN_PIPELINED
+        disyn::dsp::FrontTick();
+#else
+        disyn::dsp::Tick();
+#endif
+        const std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+        totalMicros += elapsed.count();
+        worstMicros = std::max(worstMicros, elapsed.count());
+    }
+
+    running.store(false);
+    control.join();
+
+    disyn::StatusMessage status{};
+    disyn::gStatusMailbox.receive(status);
+
+    const double budgetMicros = 1.0e6 * kBlockFrames / kSampleRate;
+    std::cout << "algorithm " << static_cast<int>(params.algorithm) << " ("
+              << disyn::GetAlgorithmInfo(params.algorithm).name << ")\n"
+              << "blocks " << blocks << " x " << kBlockFrames << " frames at " << kSampleRate << " Hz\n"
+              << "tick mean " << totalMicros / static_cast<double>(blocks) << " us, worst " << worstMicros
+              << " us, budget " << budgetMicros << " us\n"
+              << "underruns " << status.underruns << ", audio " << (status.audioOk ? "ok" : "failed")
+              << ", peak " << static_cast<double>(peakDeviation.load()) / 32768.0 << "\n";
+    return 0;
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+// Host stand-in for the parts of the Arduino core the DSP path touches. Serial writes to
+// stderr so stdout stays free for tool output.
+
+#include <cstddef>
+#include <cstdint>
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <freertos/task.h>
+
+constexpr int LOW = 0;
+constexpr int HIGH = 1;
+constexpr int INPUT = 0x01;
+constexpr int OUTPUT = 0x03;
+
+class HardwareSerial
+{
+public:
+    void begin(unsigned long baud);
+    void flush();
+
+    size_t print(const char *text);
+    size_t print(char value);
+    size_t print(int value);
+    size_t print(unsigned int value);
+    size_t print(long value);
+    size_t print(unsigned long value);
+    size_t print(double value, int digits = 2);
+
+    size_t println();
+    template <typename T>
+    size_t println(T value)
+    {
+        const size_t written = print(value);
+        return written + println();
+    }
+};
+
+extern HardwareSerial Serial;
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
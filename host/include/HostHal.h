@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+// Controls for the host implementations of the disyn::hal classes.
+namespace disyn::host {
+
+// Level seen by hal::Gate::read(); true means the gate input is high.
+void setGateInput(bool high);
+
+// Last level written through hal::Gate::write().
+bool gateOutput();
+
+// Receives every buffer passed to hal::AudioOutput::write(): interleaved left/right DAC
+// words, count is the number of uint16_t values.
+using AudioSink = std::function<void(const uint16_t *samples, size_t count)>;
+void setAudioSink(AudioSink sink);
+
+// When enabled, hal::AudioOutput::write() blocks like the I2S DMA: at most eight buffers
+// may be queued ahead of a clock running at the sample rate. Off by default, so the DSP
+// path runs as fast as the host allows.
+void setRealtimeAudio(bool enabled);
+
+} // namespace disyn::host
@@ -0,0 +1,19 @@
+#pragma once
+
+// Host stand-in for the subset of FreeRTOS used by the firmware. Ticks are milliseconds.
+
+#include <cstdint>
+
+using BaseType_t = int;
+using UBaseType_t = unsigned int;
+using TickType_t = uint32_t;
+
+constexpr BaseType_t pdFALSE = 0;
+constexpr BaseType_t pdTRUE = 1;
+constexpr BaseType_t pdFAIL = pdFALSE;
+constexpr BaseType_t pdPASS = pdTRUE;
+
+constexpr TickType_t portMAX_DELAY = 0xFFFFFFFFu;
+constexpr TickType_t portTICK_PERIOD_MS = 1;
+
+#define pdMS_TO_TICKS(ms) (static_cast<TickType_t>(ms) / portTICK_PERIOD_MS)
@@ -0,0 +1,18 @@
+#pragma once
+
+#include "FreeRTOS.h"
+
+// Fixed-size copy-in/copy-out queues guarded by a std::mutex, with the FreeRTOS blocking
+// semantics: a call waits up to ticksToWait for space or data, forever for portMAX_DELAY.
+struct QueueDefinition;
+using QueueHandle_t = QueueDefinition *;
+
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t itemSize);
+void vQueueDelete(QueueHandle_t queue);
+
+BaseType_t xQueueSend(QueueHandle_t queue, const void *item, TickType_t ticksToWait);
+BaseType_t xQueueSendToBack(QueueHandle_t queue, const void *item, TickType_t ticksToWait);
+BaseType_t xQueueOverwrite(QueueHandle_t queue, const void *item);
+BaseType_t xQueueReceive(QueueHandle_t queue, void *item, TickType_t ticksToWait);
+BaseType_t xQueuePeek(QueueHandle_t queue, void *item, TickType_t ticksToWait);
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t queue);
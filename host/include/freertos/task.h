@@ -0,0 +1,24 @@
+#pragma once
+
+#include "FreeRTOS.h"
+
+// Tasks run on detached std::threads; stack size, priority and core are ignored.
+struct tskTaskControlBlock;
+using TaskHandle_t = tskTaskControlBlock *;
+using TaskFunction_t = void (*)(void *);
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t function, const char *name, uint32_t stackDepth,
+                                   void *parameters, UBaseType_t priority, TaskHandle_t *handle,
+                                   BaseType_t coreId);
+BaseType_t xTaskCreate(TaskFunction_t function, const char *name, uint32_t stackDepth, void *parameters,
+                       UBaseType_t priority, TaskHandle_t *handle);
+
+// Direct-to-task notifications, used as a counting semaphore. A thread that was not started
+// through xTaskCreate* gets a handle of its own the first time it asks for one.
+TaskHandle_t xTaskGetCurrentTaskHandle();
+BaseType_t xTaskNotifyGive(TaskHandle_t task);
+uint32_t ulTaskNotifyTake(BaseType_t clearCountOnExit, TickType_t ticksToWait);
+
+void vTaskDelay(TickType_t ticks);
+TickType_t xTaskGetTickCount();
+BaseType_t xPortGetCoreID();
@@ -0,0 +1,96 @@
+#include <Arduino.h>
+
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+
+HardwareSerial Serial;
+
+namespace {
+
+std::mutex serialMutex;
+const auto startTime = std::chrono::steady_clock::now();
+
+template <typename... Args>
+size_t printFormatted(const char *format, Args... args)
+{
+    std::lock_guard<std::mutex> lock(serialMutex);
+    const int written = std::fprintf(stderr, format, args...);
+    return written > 0 ? static_cast<size_t>(written) : 0;
+}
+
+} // namespace
+
+void HardwareSerial::begin(unsigned long baud)
+{
+    (void)baud;
+}
+
+void HardwareSerial::flush()
+{
+    std::lock_guard<std::mutex> lock(serialMutex);
+    std::fflush(stderr);
+}
+
+size_t HardwareSerial::print(const char *text)
+{
+    return printFormatted("%s", text);
+}
+
+size_t HardwareSerial::print(char value)
+{
+    return printFormatted("%c", value);
+}
+
+size_t HardwareSerial::print(int value)
+{
+    return printFormatted("%d", value);
+}
+
+size_t HardwareSerial::print(unsigned int value)
+{
+    return printFormatted("%u", value);
+}
+
+size_t HardwareSerial::print(long value)
+{
+    return printFormatted("%ld", value);
+}
+
+size_t HardwareSerial::print(unsigned long value)
+{
+    return printFormatted("%lu", value);
+}
+
+size_t HardwareSerial::print(double value, int digits)
+{
+    return printFormatted("%.*f", digits, value);
+}
+
+size_t HardwareSerial::println()
+{
+    return printFormatted("\r\n");
+}
+
+unsigned long millis()
+{
+    const auto elapsed = std::chrono::steady_clock::now() - startTime;
+    return static_cast<unsigned long>(std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count());
+}
+
+unsigned long micros()
+{
+    const auto elapsed = std::chrono::steady_clock::now() - startTime;
+    return static_cast<unsigned long>(std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count());
+}
+
+void delay(unsigned long ms)
+{
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+void delayMicroseconds(unsigned int us)
+{
+    std::this_thread::sleep_for(std::chrono::microseconds(us));
+}
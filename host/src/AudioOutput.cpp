@@ -0,0 +1,96 @@
+#include "hal/AudioOutput.h"
+
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+#include "HostHal.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Matches dma_buf_count in the firmware's I2S configuration.
+constexpr int kDmaBufferCount = 8;
+
+std::mutex outputMutex;
+disyn::host::AudioSink audioSink;
+bool realtime = false;
+int outputSampleRate = 0;
+int outputBufferLength = 0;
+Clock::time_point playhead;
+
+} // namespace
+
+namespace disyn::host {
+
+void setAudioSink(AudioSink sink)
+{
+    std::lock_guard<std::mutex> lock(outputMutex);
+    audioSink = std::move(sink);
+}
+
+void setRealtimeAudio(bool enabled)
+{
+    std::lock_guard<std::mutex> lock(outputMutex);
+    realtime = enabled;
+    playhead = Clock::now();
+}
+
+} // namespace disyn::host
+
+namespace disyn::hal {
+
+bool AudioOutput::begin(int sampleRate, int bufferLength)
+{
+    if (sampleRate <= 0 || bufferLength <= 0)
+    {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(outputMutex);
+    outputSampleRate = sampleRate;
+    outputBufferLength = bufferLength;
+    playhead = Clock::now();
+    return true;
+}
+
+bool AudioOutput::write(const uint16_t *buffer, size_t length, size_t *bytesWritten)
+{
+    std::unique_lock<std::mutex> lock(outputMutex);
+    if (outputSampleRate <= 0)
+    {
+        *bytesWritten = 0;
+        return false;
+    }
+
+    const size_t count = length / sizeof(uint16_t);
+    if (audioSink)
+    {
+        audioSink(buffer, count);
+    }
+
+    if (realtime)
+    {
+        // The playhead is when the last queued frame will have played. Wait while more than
+        // the DMA ring is queued ahead of now, as i2s_write does with portMAX_DELAY.
+        const auto frames = static_cast<long long>(count / 2);
+        const auto now = Clock::now();
+        if (playhead < now)
+        {
+            playhead = now;
+        }
+        playhead += std::chrono::nanoseconds(frames * 1000000000LL / outputSampleRate);
+        const auto lead = std::chrono::nanoseconds(
+            static_cast<long long>(kDmaBufferCount) * outputBufferLength * 1000000000LL / outputSampleRate);
+        const auto wakeAt = playhead - lead;
+        lock.unlock();
+        std::this_thread::sleep_until(wakeAt);
+    }
+
+    *bytesWritten = length;
+    return true;
+}
+
+} // namespace disyn::hal
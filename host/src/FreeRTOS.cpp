@@ -0,0 +1,228 @@
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <freertos/task.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+struct QueueDefinition
+{
+    QueueDefinition(UBaseType_t length, UBaseType_t itemSize)
+        : length(length), itemSize(itemSize), storage(static_cast<size_t>(length) * itemSize)
+    {
+    }
+
+    const UBaseType_t length;
+    const UBaseType_t itemSize;
+    std::vector<uint8_t> storage;
+    UBaseType_t head = 0;
+    UBaseType_t count = 0;
+    std::mutex mutex;
+    std::condition_variable changed;
+};
+
+struct tskTaskControlBlock
+{
+    TaskFunction_t function = nullptr;
+    void *parameters = nullptr;
+    BaseType_t coreId = 0;
+    uint32_t notifications = 0;
+    std::mutex mutex;
+    std::condition_variable notified;
+};
+
+namespace {
+
+const auto startTime = std::chrono::steady_clock::now();
+thread_local BaseType_t currentCore = 0;
+thread_local tskTaskControlBlock *currentTask = nullptr;
+
+// Waits on the queue's condition variable with FreeRTOS timeout semantics; returns the
+// predicate's final value. The caller holds lock.
+template <typename Predicate>
+bool waitFor(QueueDefinition &queue, std::unique_lock<std::mutex> &lock, TickType_t ticksToWait,
+             Predicate ready)
+{
+    if (ticksToWait == portMAX_DELAY)
+    {
+        queue.changed.wait(lock, ready);
+        return true;
+    }
+    return queue.changed.wait_for(lock, std::chrono::milliseconds(ticksToWait * portTICK_PERIOD_MS), ready);
+}
+
+uint8_t *slot(QueueDefinition &queue, UBaseType_t index)
+{
+    return queue.storage.data() + static_cast<size_t>(index % queue.length) * queue.itemSize;
+}
+
+} // namespace
+
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t itemSize)
+{
+    if (length == 0 || itemSize == 0)
+    {
+        return nullptr;
+    }
+    return new QueueDefinition(length, itemSize);
+}
+
+void vQueueDelete(QueueHandle_t queue)
+{
+    delete queue;
+}
+
+BaseType_t xQueueSend(QueueHandle_t queue, const void *item, TickType_t ticksToWait)
+{
+    std::unique_lock<std::mutex> lock(queue->mutex);
+    if (!waitFor(*queue, lock, ticksToWait, [queue] { return queue->count < queue->length; }))
+    {
+        return pdFAIL;
+    }
+    std::memcpy(slot(*queue, queue->head + queue->count), item, queue->itemSize);
+    ++queue->count;
+    lock.unlock();
+    queue->changed.notify_all();
+    return pdPASS;
+}
+
+BaseType_t xQueueSendToBack(QueueHandle_t queue, const void *item, TickType_t ticksToWait)
+{
+    return xQueueSend(queue, item, ticksToWait);
+}
+
+// Like FreeRTOS, only meaningful for queues of length one: the single item is replaced.
+BaseType_t xQueueOverwrite(QueueHandle_t queue, const void *item)
+{
+    {
+        std::lock_guard<std::mutex> lock(queue->mutex);
+        std::memcpy(slot(*queue, queue->head), item, queue->itemSize);
+        queue->count = 1;
+    }
+    queue->changed.notify_all();
+    return pdPASS;
+}
+
+BaseType_t xQueueReceive(QueueHandle_t queue, void *item, TickType_t ticksToWait)
+{
+    std::unique_lock<std::mutex> lock(queue->mutex);
+    if (!waitFor(*queue, lock, ticksToWait, [queue] { return queue->count > 0; }))
+    {
+        return pdFALSE;
+    }
+    std::memcpy(item, slot(*queue, queue->head), queue->itemSize);
+    queue->head = (queue->head + 1) % queue->length;
+    --queue->count;
+    lock.unlock();
+    queue->changed.notify_all();
+    return pdTRUE;
+}
+
+BaseType_t xQueuePeek(QueueHandle_t queue, void *item, TickType_t ticksToWait)
+{
+    std::unique_lock<std::mutex> lock(queue->mutex);
+    if (!waitFor(*queue, lock, ticksToWait, [queue] { return queue->count > 0; }))
+    {
+        return pdFALSE;
+    }
+    std::memcpy(item, slot(*queue, queue->head), queue->itemSize);
+    return pdTRUE;
+}
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t queue)
+{
+    std::lock_guard<std::mutex> lock(queue->mutex);
+    return queue->count;
+}
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t function, const char *name, uint32_t stackDepth,
+                                   void *parameters, UBaseType_t priority, TaskHandle_t *handle,
+                                   BaseType_t coreId)
+{
+    (void)name;
+    (void)stackDepth;
+    (void)priority;
+
+    // Tasks never return on the firmware, so the control block lives for the whole process.
+    auto *task = new tskTaskControlBlock;
+    task->function = function;
+    task->parameters = parameters;
+    task->coreId = coreId;
+    std::thread([task] {
+        currentCore = task->coreId;
+        currentTask = task;
+        task->function(task->parameters);
+    }).detach();
+
+    if (handle != nullptr)
+    {
+        *handle = task;
+    }
+    return pdPASS;
+}
+
+BaseType_t xTaskCreate(TaskFunction_t function, const char *name, uint32_t stackDepth, void *parameters,
+                       UBaseType_t priority, TaskHandle_t *handle)
+{
+    return xTaskCreatePinnedToCore(function, name, stackDepth, parameters, priority, handle, 0);
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle()
+{
+    if (currentTask == nullptr)
+    {
+        // Like the tasks' own control blocks, kept for the life of the process.
+        currentTask = new tskTaskControlBlock;
+        currentTask->coreId = currentCore;
+    }
+    return currentTask;
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t task)
+{
+    {
+        std::lock_guard<std::mutex> lock(task->mutex);
+        ++task->notifications;
+    }
+    task->notified.notify_all();
+    return pdPASS;
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clearCountOnExit, TickType_t ticksToWait)
+{
+    TaskHandle_t task = xTaskGetCurrentTaskHandle();
+    std::unique_lock<std::mutex> lock(task->mutex);
+    const auto ready = [task] { return task->notifications > 0; };
+    if (ticksToWait == portMAX_DELAY)
+    {
+        task->notified.wait(lock, ready);
+    }
+    else if (!task->notified.wait_for(lock, std::chrono::milliseconds(ticksToWait * portTICK_PERIOD_MS), ready))
+    {
+        return 0;
+    }
+    const uint32_t count = task->notifications;
+    task->notifications = clearCountOnExit != pdFALSE ? 0 : count - 1;
+    return count;
+}
+
+void vTaskDelay(TickType_t ticks)
+{
+    std::this_thread::sleep_for(std::chrono::milliseconds(ticks * portTICK_PERIOD_MS));
+}
+
+TickType_t xTaskGetTickCount()
+{
+    const auto elapsed = std::chrono::steady_clock::now() - startTime;
+    return static_cast<TickType_t>(std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count() /
+                                   portTICK_PERIOD_MS);
+}
+
+BaseType_t xPortGetCoreID()
+{
+    return currentCore;
+}
@@ -0,0 +1,46 @@
+#include "hal/Gate.h"
+
+#include <atomic>
+
+#include "HostHal.h"
+
+namespace {
+
+std::atomic<bool> gateInput{false};
+std::atomic<bool> gateOutputLevel{false};
+
+} // namespace
+
+namespace disyn::host {
+
+void setGateInput(bool high)
+{
+    gateInput.store(high);
+}
+
+bool gateOutput()
+{
+    return gateOutputLevel.load();
+}
+
+} // namespace disyn::host
+
+namespace disyn::hal {
+
+void Gate::begin(int pinIn, int pinOut)
+{
+    pinIn_ = pinIn;
+    pinOut_ = pinOut;
+}
+
+bool Gate::read() const
+{
+    return gateInput.load();
+}
+
+void Gate::write(bool high)
+{
+    gateOutputLevel.store(high);
+}
+
+} // namespace disyn::hal
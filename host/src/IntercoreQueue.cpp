@@ -0,0 +1,5 @@
+#include "IntercoreQueue.h"
+
+// Defined in main.cpp on the firmware.
+disyn::Mailbox<disyn::ParamMessage> disyn::gParamMailbox;
+disyn::Mailbox<disyn::StatusMessage> disyn::gStatusMailbox;
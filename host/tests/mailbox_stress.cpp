@@ -0,0 +1,105 @@
+// Stress test for disyn::Mailbox (include/IntercoreQueue.h): a producer thread publishes
+// numbered payloads as fast as it can while a consumer thread receives them. Every value
+// received must be complete (no slot written while it was being read), newer than the one
+// before it, and the consumer must end on the last value published.
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+
+#include "IntercoreQueue.h"
+
+namespace {
+
+constexpr uint64_t kPublishes = 2000000;
+
+// Larger than Parameters so a torn copy is easy to catch.
+struct Payload {
+    uint64_t sequence = 0;
+    std::array<uint64_t, 31> words{};
+};
+
+Payload makePayload(uint64_t sequence) {
+    Payload payload;
+    payload.sequence = sequence;
+    for (size_t i = 0; i < payload.words.size(); ++i) {
+        payload.words[i] = sequence * 0x9E3779B97F4A7C15ull + i;
+    }
+    return payload;
+}
+
+bool isConsistent(const Payload& payload) {
+    return payload.words == makePayload(payload.sequence).words;
+}
+
+int runStress() {
+    disyn::Mailbox<Payload> mailbox;
+    std::atomic<bool> done{false};
+    uint64_t received = 0;
+    uint64_t torn = 0;
+    uint64_t outOfOrder = 0;
+    uint64_t last = 0;
+
+    std::thread consumer([&]() {
+        Payload payload;
+        for (;;) {
+            const bool finished = done.load(std::memory_order_acquire);
+            while (mailbox.receive(payload)) {
+                ++received;
+                torn += isConsistent(payload) ? 0 : 1;
+                outOfOrder += payload.sequence > last ? 0 : 1;
+                last = payload.sequence;
+            }
+            if (finished) {
+                break;
+            }
+            std::this_thread::yield();
+        }
+    });
+    std::thread producer([&]() {
+        for (uint64_t sequence = 1; sequence <= kPublishes; ++sequence) {
+            mailbox.publish(makePayload(sequence));
+            // Hand the core over now and then so the threads interleave on single-core hosts.
+            if (sequence % 64 == 0) {
+                std::this_thread::yield();
+            }
+        }
+        done.store(true, std::memory_order_release);
+    });
+    producer.join();
+    consumer.join();
+
+    std::cout << "published " << kPublishes << ", received " << received << ", torn " << torn
+              << ", out of order " << outOfOrder << ", last " << last << std::endl;
+    return torn == 0 && outOfOrder == 0 && last == kPublishes && received > 0 ? 0 : 1;
+}
+
+// Receive reports each value once and leaves the output alone when nothing new arrived.
+int runSequential() {
+    disyn::Mailbox<disyn::StatusMessage> mailbox;
+    disyn::StatusMessage status{};
+    status.underruns = 7;
+    if (mailbox.receive(status) || status.underruns != 7) {
+        std::cerr << "receive on an empty mailbox changed the value" << std::endl;
+        return 1;
+    }
+    for (uint32_t i = 1; i <= 3; ++i) {
+        disyn::StatusMessage message{};
+        message.underruns = i;
+        mailbox.publish(message);
+    }
+    if (!mailbox.receive(status) || status.underruns != 3 || mailbox.receive(status)) {
+        std::cerr << "receive did not return only the newest value" << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+} // namespace
+
+int main() {
+    return runSequential() != 0 || runStress() != 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+}
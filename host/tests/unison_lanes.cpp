@@ -0,0 +1,199 @@
+// Checks for OscillatorModule's unison lanes: one voice renders bit-identically to the plain
+// algorithm whatever the detune and spread, each side's lane gains sum to one, lanes added later
+// start from lane 0's phase while the others carry on, and lane 0 picks up the single copy's
+// phase and hands it back, so a copy that went through unison with no detune comes back
+// sample for sample the same as one that never did. Every algorithm in the build stacks, with
+// or without a lane kernel, and reset() restarts every lane.
+
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+#include "dsp/modules/OscillatorModule.hpp"
+
+namespace {
+
+using flues::disyn::AlgorithmType;
+using flues::disyn::OscillatorModule;
+
+constexpr float kSampleRate = 44100.0f;
+constexpr int kBlockSize = 64;
+constexpr int kBlocks = 200;
+constexpr uint32_t kGolden = 0x9E3779B9u;
+
+int failures = 0;
+
+void fail(const std::string& what) {
+    std::cerr << "FAIL: " << what << "\n";
+    ++failures;
+}
+
+std::string nameOf(AlgorithmType type) {
+    return flues::disyn::algorithmDescriptor(type).info.name;
+}
+
+// Renders kBlocks blocks with moving pitch and params; before each block, configure(block)
+// may change the unison settings.
+template <typename Configure>
+std::vector<float> render(OscillatorModule& oscillator, AlgorithmType type, Configure configure) {
+    std::vector<float> output(static_cast<size_t>(kBlocks) * kBlockSize * 2);
+    for (int block = 0; block < kBlocks; ++block) {
+        configure(block);
+        const float pitch = 110.0f + static_cast<float>(block % 13) * 20.0f;
+        const float param = static_cast<float>(block % 7) / 6.0f;
+        float* primary = &output[static_cast<size_t>(block) * kBlockSize * 2];
+        oscillator.processBlock(type, pitch, param, 1.0f - param, 0.5f, primary, primary + kBlockSize, kBlockSize);
+    }
+    return output;
+}
+
+bool identical(const std::vector<float>& a, const std::vector<float>& b, size_t from = 0) {
+    return std::memcmp(a.data() + from, b.data() + from, (a.size() - from) * sizeof(float)) == 0;
+}
+
+void checkSingleVoice() {
+    for (const AlgorithmType type : flues::disyn::kActiveAlgorithms) {
+        OscillatorModule plain(kSampleRate);
+        OscillatorModule unison(kSampleRate);
+        unison.setUnison(1, 0.7f, 0.4f);
+        const std::vector<float> expected = render(plain, type, [](int) {});
+        const std::vector<float> actual = render(unison, type, [](int) {});
+        if (!identical(expected, actual)) {
+            fail(nameOf(type) + ": one unison voice differs from the plain algorithm");
+        }
+    }
+}
+
+void checkGains() {
+    OscillatorModule oscillator(kSampleRate);
+    for (int voices = 2; voices <= OscillatorModule::kMaxUnisonVoices; ++voices) {
+        for (const float spread : {0.0f, 0.5f, 1.0f}) {
+            oscillator.setUnison(voices, 0.5f, spread);
+            const OscillatorModule::UnisonLanes& lanes = oscillator.unison();
+            float left = 0.0f;
+            float right = 0.0f;
+            for (int lane = 0; lane < OscillatorModule::kMaxUnisonVoices; ++lane) {
+                if (lane >= voices && (lanes.gainLeft[lane] != 0.0f || lanes.gainRight[lane] != 0.0f)) {
+                    fail("lane " + std::to_string(lane) + " past " + std::to_string(voices) + " voices has gain");
+                }
+                left += lanes.gainLeft[lane];
+                right += lanes.gainRight[lane];
+            }
+            if (std::abs(left - 1.0f) > 1e-5f || std::abs(right - 1.0f) > 1e-5f) {
+                fail(std::to_string(voices) + " voices, spread " + std::to_string(spread) +
+                     ": gains sum to " + std::to_string(left) + " / " + std::to_string(right));
+            }
+        }
+    }
+    oscillator.setUnison(12, 2.0f, -1.0f);
+    if (oscillator.unison().count != OscillatorModule::kMaxUnisonVoices || oscillator.unison().detune != 1.0f ||
+        oscillator.unison().spread != 0.0f) {
+        fail("setUnison does not clamp its arguments");
+    }
+    oscillator.setUnison(0, 0.0f, 0.0f);
+    if (oscillator.unison().count != 1) {
+        fail("setUnison(0) is not one voice");
+    }
+}
+
+void checkLaneAddAndReset() {
+    OscillatorModule oscillator(kSampleRate);
+    float primary[kBlockSize];
+    float secondary[kBlockSize];
+    oscillator.setUnison(3, 0.3f, 1.0f);
+    for (int block = 0; block < 10; ++block) {
+        oscillator.processBlock(AlgorithmType::SINE, 220.0f, 0.0f, 0.0f, 0.0f, primary, secondary, kBlockSize);
+    }
+    const OscillatorModule::UnisonLanes before = oscillator.unison();
+    oscillator.setUnison(5, 0.3f, 1.0f);
+    const OscillatorModule::UnisonLanes& after = oscillator.unison();
+    for (int lane = 0; lane < 3; ++lane) {
+        if (after.phase[lane] != before.phase[lane]) {
+            fail("lane " + std::to_string(lane) + " restarted when lanes were added");
+        }
+    }
+    for (int lane = 3; lane < 5; ++lane) {
+        if (after.phase[lane] != after.phase[0] + static_cast<uint32_t>(lane) * kGolden ||
+            after.slewPrimary[lane] != 0.0f || after.slewSecondary[lane] != 0.0f) {
+            fail("added lane " + std::to_string(lane) + " is not seeded from lane 0");
+        }
+    }
+
+    oscillator.reset();
+    const OscillatorModule::UnisonLanes& reset = oscillator.unison();
+    for (int lane = 0; lane < OscillatorModule::kMaxUnisonVoices; ++lane) {
+        if (reset.phase[lane] != static_cast<uint32_t>(lane) * kGolden || reset.slewPrimary[lane] != 0.0f) {
+            fail("lane " + std::to_string(lane) + " not cleared by reset()");
+        }
+    }
+    if (reset.active || reset.count != 5) {
+        fail("reset() changed the unison settings or left the lanes active");
+    }
+}
+
+// Unison with no detune for a stretch in the middle: lane 0 runs at the single copy's pitch
+// from its phase and slew, so once unison is off again the output must match exactly.
+void checkHandOver() {
+    for (const AlgorithmType type : flues::disyn::kActiveAlgorithms) {
+        if (!OscillatorModule::supportsUnison(type)) {
+            fail(nameOf(type) + ": does not stack unison copies");
+        }
+        OscillatorModule plain(kSampleRate);
+        OscillatorModule unison(kSampleRate);
+        const std::vector<float> expected = render(plain, type, [](int) {});
+        const std::vector<float> actual = render(unison, type, [&unison](int block) {
+            unison.setUnison(block >= 50 && block < 120 ? 4 : 1, 0.0f, 0.8f);
+        });
+        if (identical(expected, actual)) {
+            fail(nameOf(type) + ": unison did not change the output");
+        }
+        if (!identical(expected, actual, static_cast<size_t>(120) * kBlockSize * 2)) {
+            fail(nameOf(type) + ": the single copy does not carry on from lane 0");
+        }
+    }
+}
+
+// After reset() a module that played unison renders as one that never played. Algorithms
+// whose own reset keeps state (Noise's generator) are left out, as one copy would differ too.
+bool resetsCleanly(AlgorithmType type) {
+    OscillatorModule fresh(kSampleRate);
+    OscillatorModule used(kSampleRate);
+    render(used, type, [](int) {});
+    used.reset();
+    return identical(render(fresh, type, [](int) {}), render(used, type, [](int) {}));
+}
+
+void checkReset() {
+    for (const AlgorithmType type : flues::disyn::kActiveAlgorithms) {
+        if (!resetsCleanly(type)) {
+            continue;
+        }
+        OscillatorModule fresh(kSampleRate);
+        OscillatorModule used(kSampleRate);
+        fresh.setUnison(3, 0.4f, 0.6f);
+        used.setUnison(3, 0.4f, 0.6f);
+        render(used, type, [](int) {});
+        used.reset();
+        const std::vector<float> expected = render(fresh, type, [](int) {});
+        const std::vector<float> actual = render(used, type, [](int) {});
+        if (!identical(expected, actual)) {
+            fail(nameOf(type) + ": reset() does not restart the unison lanes");
+        }
+    }
+}
+
+} // namespace
+
+int main() {
+    checkSingleVoice();
+    checkGains();
+    checkLaneAddAndReset();
+    checkHandOver();
+    checkReset();
+    if (failures > 0) {
+        return 1;
+    }
+    std::cout << "OK: unison lanes\n";
+    return 0;
+}
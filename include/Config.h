@@ -6,6 +6,12 @@
 
 constexpr int kSampleRate = DISYN_SAMPLE_RATE;
 
+// 1 splits the DSP chain across both cores: oscillator and wavefolder on core 1, envelope,
+// reverb and audio output on core 0, one block behind. Adds one block of latency.
+#ifndef DISYN_PIPELINED
+#define DISYN_PIPELINED 0
+#endif
+
 constexpr float kParamModAmount = 0.5f;
 constexpr float kPitchCvMix = 0.5f;           // was .7
 constexpr float kPitchPotMix = 0.5f;          // was .3
@@ -1,11 +1,122 @@
 #pragma once
 
-#include <freertos/FreeRTOS.h>
-#include <freertos/queue.h>
+#include <atomic>
+#include <cstdint>
 
-namespace disyn {
+#include "Parameters.h"
 
-extern QueueHandle_t gParamQueue;
-extern QueueHandle_t gStatusQueue;
+namespace disyn
+{
+
+    // Latest-value mailbox between one producer and one consumer on different cores: a triple
+    // buffer. The producer fills its own back slot and swaps it with the shared middle slot;
+    // the consumer swaps the middle slot for its front slot only when a newer value is there.
+    // Each side does one atomic exchange per call and never waits, so unlike a length-1
+    // FreeRTOS queue there is no critical section and no interrupt masking on either core.
+    // A value published twice before the consumer looks is overwritten, as with xQueueOverwrite.
+    template <typename T>
+    class Mailbox
+    {
+    public:
+        // Producer side.
+        void publish(const T &value)
+        {
+            producerSlot() = value;
+            commit();
+        }
+
+        // Producer side, for values built up in place: the slot the next commit() publishes.
+        // It belongs to the producer until then; after commit() it is a different slot.
+        T &producerSlot()
+        {
+            return slots[back];
+        }
+
+        void commit()
+        {
+            const uint32_t previous = middle.exchange(back | kFresh, std::memory_order_acq_rel);
+            back = previous & kIndexMask;
+        }
+
+        // Consumer side. Copies the newest value into value and returns true if one was
+        // published since the last successful receive; otherwise leaves value untouched.
+        bool receive(T &value)
+        {
+            if ((middle.load(std::memory_order_relaxed) & kFresh) == 0u)
+            {
+                return false;
+            }
+            const uint32_t previous = middle.exchange(front, std::memory_order_acq_rel);
+            front = previous & kIndexMask;
+            value = slots[front];
+            return true;
+        }
+
+    private:
+        static constexpr uint32_t kIndexMask = 0x3u;
+        static constexpr uint32_t kFresh = 0x4u;
+
+        T slots[3] = {};
+        // 32-bit so the exchange is a native compare-and-swap on the ESP32 as well.
+        std::atomic<uint32_t> middle{1u};
+        uint32_t back = 0u;  // producer only
+        uint32_t front = 2u; // consumer only
+    };
+
+    // First-in first-out queue of Capacity slots between one producer and one consumer on
+    // different cores, for data that must not be dropped, such as audio blocks handed down a
+    // pipeline. Slots are used in place: the producer fills acquireSlot() and calls push(), the
+    // consumer reads frontSlot() and calls pop(). Both return nullptr when the queue is full or
+    // empty and never wait, so the caller chooses how to block. A slot keeps what either side
+    // last wrote to it, which lets the consumer send a reply back with the slot.
+    template <typename T, uint32_t Capacity>
+    class BlockQueue
+    {
+        static_assert(Capacity > 0u && (Capacity & (Capacity - 1u)) == 0u,
+                      "Capacity must be a power of two so the counters wrap cleanly");
+
+    public:
+        // Producer side.
+        T *acquireSlot()
+        {
+            const uint32_t head = pushed.load(std::memory_order_relaxed);
+            if (head - popped.load(std::memory_order_acquire) == Capacity)
+            {
+                return nullptr;
+            }
+            return &slots[head % Capacity];
+        }
+
+        void push()
+        {
+            pushed.store(pushed.load(std::memory_order_relaxed) + 1u, std::memory_order_release);
+        }
+
+        // Consumer side.
+        T *frontSlot()
+        {
+            const uint32_t tail = popped.load(std::memory_order_relaxed);
+            if (pushed.load(std::memory_order_acquire) == tail)
+            {
+                return nullptr;
+            }
+            return &slots[tail % Capacity];
+        }
+
+        void pop()
+        {
+            popped.store(popped.load(std::memory_order_relaxed) + 1u, std::memory_order_release);
+        }
+
+    private:
+        T slots[Capacity] = {};
+        std::atomic<uint32_t> pushed{0u}; // written by the producer only
+        std::atomic<uint32_t> popped{0u}; // written by the consumer only
+    };
+
+    // UI core to DSP core, published every UI frame.
+    extern Mailbox<ParamMessage> gParamMailbox;
+    // DSP core to UI core, published every audio block.
+    extern Mailbox<StatusMessage> gStatusMailbox;
 
 } // namespace disyn
@@ -2,12 +2,14 @@
 
 #include <cstdint>
 
+#include "dsp/algorithms/AlgorithmRegistry.hpp"
+
 namespace disyn
 {
 
     struct Parameters
     {
-        uint8_t algorithm = 0;
+        uint8_t algorithm = static_cast<uint8_t>(flues::disyn::kActiveAlgorithms[0]);
         float attack = 0.1f;
         float decay = 0.5f;
         float reverbSize = 0.1f;
@@ -23,6 +25,8 @@ namespace disyn
         float pot0 = 0.0f;
         float pot1 = 0.0f;
         float pot2 = 0.0f;
+        uint8_t scopeSource = 4;      // disyn::ScopeSource, CV2 (pitch CV)
+        uint16_t scopeDecimation = 1; // samples per scope column
     };
 
     struct ParamMessage
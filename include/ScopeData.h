@@ -1,10 +1,218 @@
 #pragma once
 
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+
+#include "IntercoreQueue.h"
+
 namespace disyn
 {
 
+    // One column per display pixel.
     constexpr int kScopeSize = 128;
-    extern float gScopeBuffer[kScopeSize];
-    extern volatile int gScopeIndex;
+    constexpr int kScopeMaxDecimation = 1024;
+
+    enum class ScopeSource : uint8_t
+    {
+        OUTPUT_LEFT, // final output, -1..1
+        OUTPUT_RIGHT,
+        CV0, // control inputs, 0..1, constant across an audio block
+        CV1,
+        CV2,
+        COUNT
+    };
+
+    // A complete, triggered sweep: the min and max of each column's decimation samples.
+    struct ScopeFrame
+    {
+        float minValue[kScopeSize];
+        float maxValue[kScopeSize];
+        ScopeSource source;
+        uint16_t decimation;
+        bool triggered; // false when the sweep started on the auto-trigger timeout
+    };
+
+    // DSP core to UI core, one frame per completed sweep.
+    extern Mailbox<ScopeFrame> gScopeMailbox;
+
+    // Records one signal into min/max columns and publishes each complete sweep to a mailbox.
+    // Runs once per audio block on the DSP core, outside the per-sample loop. A sweep starts on
+    // a rising crossing of the previous sweep's mid level, or after one sweep's worth of
+    // samples without one, so slow or DC signals still update.
+    class ScopeCapture
+    {
+    public:
+        explicit ScopeCapture(Mailbox<ScopeFrame> &mailbox)
+            : mailbox(mailbox)
+        {
+        }
+
+        // Takes effect at once and restarts the sweep when either setting changes.
+        void configure(ScopeSource nextSource, int nextDecimation)
+        {
+            if (nextSource >= ScopeSource::COUNT)
+            {
+                nextSource = ScopeSource::CV2;
+            }
+            nextDecimation = std::clamp(nextDecimation, 1, kScopeMaxDecimation);
+            if (nextSource == source && nextDecimation == decimation)
+            {
+                return;
+            }
+            source = nextSource;
+            decimation = nextDecimation;
+            triggerLevel = source == ScopeSource::OUTPUT_LEFT || source == ScopeSource::OUTPUT_RIGHT ? 0.0f : 0.5f;
+            arm();
+        }
+
+        ScopeSource selectedSource() const
+        {
+            return source;
+        }
+
+        void capture(const float *samples, int frames)
+        {
+            int index = 0;
+            while (index < frames)
+            {
+                if (armed)
+                {
+                    index = findTrigger(samples, index, frames);
+                    continue;
+                }
+                const int count = std::min(frames - index, remaining);
+                float low = columnMin;
+                float high = columnMax;
+                for (int i = index; i < index + count; ++i)
+                {
+                    low = std::min(low, samples[i]);
+                    high = std::max(high, samples[i]);
+                }
+                columnMin = low;
+                columnMax = high;
+                index += count;
+                remaining -= count;
+                if (remaining == 0)
+                {
+                    finishColumn();
+                }
+            }
+            if (frames > 0)
+            {
+                previous = samples[frames - 1];
+            }
+        }
+
+        // A block-constant signal: one min/max update per column rather than per sample.
+        void captureConstant(float value, int frames)
+        {
+            if (armed)
+            {
+                if (previous < triggerLevel && value >= triggerLevel)
+                {
+                    startSweep(true);
+                }
+                else if ((waited += frames) >= kScopeSize * decimation)
+                {
+                    startSweep(false);
+                }
+            }
+            while (!armed && frames > 0)
+            {
+                const int count = std::min(frames, remaining);
+                columnMin = std::min(columnMin, value);
+                columnMax = std::max(columnMax, value);
+                frames -= count;
+                remaining -= count;
+                if (remaining == 0)
+                {
+                    finishColumn();
+                }
+            }
+            previous = value;
+        }
+
+    private:
+        void arm()
+        {
+            armed = true;
+            waited = 0;
+        }
+
+        void startSweep(bool onTrigger)
+        {
+            armed = false;
+            triggered = onTrigger;
+            column = 0;
+            remaining = decimation;
+            columnMin = std::numeric_limits<float>::max();
+            columnMax = std::numeric_limits<float>::lowest();
+            sweepMin = columnMin;
+            sweepMax = columnMax;
+        }
+
+        // Returns the index the sweep starts at, or frames if it is still waiting.
+        int findTrigger(const float *samples, int index, int frames)
+        {
+            float last = index > 0 ? samples[index - 1] : previous;
+            for (int i = index; i < frames; ++i)
+            {
+                if (last < triggerLevel && samples[i] >= triggerLevel)
+                {
+                    startSweep(true);
+                    return i;
+                }
+                if (++waited >= kScopeSize * decimation)
+                {
+                    startSweep(false);
+                    return i;
+                }
+                last = samples[i];
+            }
+            return frames;
+        }
+
+        void finishColumn()
+        {
+            ScopeFrame &frame = mailbox.producerSlot();
+            frame.minValue[column] = columnMin;
+            frame.maxValue[column] = columnMax;
+            sweepMin = std::min(sweepMin, columnMin);
+            sweepMax = std::max(sweepMax, columnMax);
+            columnMin = std::numeric_limits<float>::max();
+            columnMax = std::numeric_limits<float>::lowest();
+            remaining = decimation;
+            if (++column < kScopeSize)
+            {
+                return;
+            }
+
+            frame.source = source;
+            frame.decimation = static_cast<uint16_t>(decimation);
+            frame.triggered = triggered;
+            mailbox.commit();
+            if (sweepMax - sweepMin > 0.01f)
+            {
+                triggerLevel = (sweepMin + sweepMax) * 0.5f;
+            }
+            arm();
+        }
+
+        Mailbox<ScopeFrame> &mailbox;
+        ScopeSource source = ScopeSource::CV2;
+        int decimation = 1;
+        bool armed = true;
+        bool triggered = false;
+        int waited = 0;
+        int column = 0;
+        int remaining = 1;
+        float columnMin = 0.0f;
+        float columnMax = 0.0f;
+        float sweepMin = 0.0f;
+        float sweepMax = 0.0f;
+        float triggerLevel = 0.5f;
+        float previous = 0.0f;
+    };
 
 } // namespace disyn
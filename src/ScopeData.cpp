@@ -3,7 +3,6 @@
 namespace disyn
 {
 
-    float gScopeBuffer[kScopeSize] = {};
-    volatile int gScopeIndex = 0;
+    Mailbox<ScopeFrame> gScopeMailbox;
 
 } // namespace disyn
@@ -1,13 +1,17 @@
 #pragma once
 
 #include <cmath>
+#include <cstdint>
 #include <algorithm>
 
 #include "algorithms/AlgorithmOutput.hpp"
+#include "algorithms/AlgorithmRegistry.hpp"
 #include "algorithms/AlgorithmTypes.hpp"
+#include "EngineEvent.hpp"
 #include "modules/OscillatorModule.hpp"
 #include "modules/WavefolderModule.hpp"
 #include "modules/EnvelopeModule.hpp"
+#include "modules/ParameterRamp.hpp"
 #include "modules/ReverbModule.hpp"
 
 namespace flues::disyn
@@ -16,39 +20,46 @@ namespace flues::disyn
     class DisynEngine
     {
     public:
+        static constexpr int kMaxBlockSize = 64;
+        static constexpr std::size_t kMaxEvents = 32;
+        // While oscillator controls ramp, the algorithm is re-prepared every this many frames.
+        static constexpr int kControlBlockSize = 16;
+
+        // One block on its way from the front stage to the back stage; see renderFront().
+        struct StageBlock
+        {
+            float left[kMaxBlockSize];
+            float right[kMaxBlockSize];
+            EventQueue<kMaxEvents> events; // what the front applied, replayed by the back
+            int frames = 0;
+            uint32_t stopNote = 0; // back stage's last report, read by the front on reuse
+        };
+
         explicit DisynEngine(float sampleRate = 44100.0f)
             : sampleRate(sampleRate),
               oscillator(sampleRate),
               wavefolder(),
-              envelope(sampleRate),
-              reverbLeft(sampleRate),
-              reverbRight(sampleRate),
               frequency(440.0f),
               algorithmType(AlgorithmType::TANH_SQUARE),
               param1(0.55f), // Default drive for tanh square
               param2(0.5f),  // Default trim for tanh square
               param3(0.5f),
               wavefoldAmount(0.0f),
+              envelope(sampleRate),
+              reverb(sampleRate),
+              backAlgorithm(AlgorithmType::TANH_SQUARE),
               masterGain(0.8f),
               velocity(1.0f),
               gate(false),
-              isPlaying(false)
+              isPlaying(false),
+              keepReverbTail(false)
         {
         }
 
         void noteOn(float freq, float vel = 1.0f)
         {
-            frequency = freq;
-            velocity = std::clamp(vel, 0.0f, 1.0f);
-            gate = true;
-            isPlaying = true;
-
-            oscillator.reset();
-            envelope.reset();
-            reverbLeft.reset();
-            reverbRight.reset();
-
-            envelope.setGate(true);
+            frontNoteOn(freq);
+            backNoteOn(vel);
         }
 
         void noteOff()
@@ -59,78 +70,117 @@ namespace flues::disyn
 
         void setFrequency(float freq)
         {
-            frequency = std::max(freq, 0.0f);
+            frequency.setTarget(std::max(freq, 0.0f));
         }
 
         AlgorithmOutput process()
         {
-            if (!isPlaying)
-            {
-                return {0.0f, 0.0f};
-            }
+            float left = 0.0f;
+            float right = 0.0f;
+            processBlock(&left, &right, 1);
+            return {left, right};
+        }
 
-            // Generate oscillator sample
-            const AlgorithmOutput oscOutput = oscillator.process(algorithmType, frequency, param1, param2, param3);
-            float primary = oscOutput.primary;
-            float secondary = oscOutput.secondary;
-            const float foldGain = getAlgorithmFoldGain(algorithmType);
-            const float outputGain = getAlgorithmOutputGain(algorithmType);
-            const float preFoldPrimary = primary * foldGain;
-            const float preFoldSecondary = secondary * foldGain;
-            const float foldedPrimary = wavefolder.process(preFoldPrimary, wavefoldAmount);
-            const float foldedSecondary = wavefolder.process(preFoldSecondary, wavefoldAmount);
-            // Prev tune: postGain 3.0 with tanh. Reverting to avoid global distortion.
-            const float postPrimary = foldedPrimary;
-            const float postSecondary = foldedSecondary;
+        // Renders frames of stereo output. Scheduled events split the call into segments and are
+        // applied on their frame; events at or past the end are applied after the last frame.
+        void processBlock(float *left, float *right, int frames)
+        {
+            render<true, true>(events, left, right, frames);
+            events.clear();
+        }
 
-            // Apply envelope
-            const float env = envelope.process();
+        // Pipelined rendering, for running the chain on two cores. renderFront() renders the
+        // oscillator and wavefolder for up to kMaxBlockSize frames into block, applying the
+        // scheduled events; renderBack() then runs the envelope, gains and reverb on that block
+        // into the output, usually on the other core while the front renders the next block.
+        // Blocks must reach renderBack() in order, through a queue that orders memory
+        // (disyn::BlockQueue). The two stages together produce exactly what processBlock()
+        // would. Between them, change the engine only through the schedule* calls from the
+        // front's side, since the direct setters reach into both stages.
+        void renderFront(StageBlock &block, int frames)
+        {
+            frames = std::min(frames, kMaxBlockSize);
+            frontStopNote = block.stopNote;
+            block.events = events;
+            block.frames = frames;
+            render<true, false>(events, block.left, block.right, frames);
+            events.clear();
+        }
 
-            // Apply velocity and master gain
-            const float leftSample = postPrimary * env * velocity * masterGain * outputGain;
-            const float rightSample = postSecondary * env * velocity * masterGain * outputGain;
+        void renderBack(StageBlock &block, float *left, float *right)
+        {
+            std::copy(block.left, block.left + block.frames, left);
+            std::copy(block.right, block.right + block.frames, right);
+            render<false, true>(block.events, left, right, block.frames);
+            block.stopNote = stopNote;
+        }
 
-            // Apply reverb
-            const float left = reverbLeft.process(leftSample);
-            const float right = reverbRight.process(rightSample);
+        // Queue a change frame samples into the next processBlock call. These return false when
+        // kMaxEvents are already pending; the caller can then apply the change directly.
+        bool scheduleNoteOn(int frame, float freq, float vel = 1.0f)
+        {
+            return events.push({frame, EngineEvent::Type::NOTE_ON, EngineParam::FREQUENCY, freq, vel});
+        }
 
-            // Voice tail detection - stop if envelope is silent
-            if (!envelope.isPlaying() &&
-                std::max(std::abs(left), std::abs(right)) < 1e-5f)
-            {
-                isPlaying = false;
-            }
+        bool scheduleNoteOff(int frame)
+        {
+            return events.push({frame, EngineEvent::Type::NOTE_OFF, EngineParam::FREQUENCY, 0.0f, 0.0f});
+        }
 
-            return {left, right};
+        bool scheduleParameter(int frame, EngineParam param, float value)
+        {
+            return events.push({frame, EngineEvent::Type::SET_PARAM, param, value, 0.0f});
+        }
+
+        void setParameter(EngineParam param, float value)
+        {
+            setStageParameter<true, true>(param, value);
         }
 
         // Parameter setters
         void setAlgorithm(int type)
         {
-            if (type >= 0 && type <= 25)
-            {
-                algorithmType = static_cast<AlgorithmType>(type);
-            }
+            selectAlgorithm<true, true>(type);
         }
 
         void setParam1(float value)
         {
-            param1 = std::clamp(value, 0.0f, 1.0f);
+            param1.setTarget(std::clamp(value, 0.0f, 1.0f));
         }
 
         void setParam2(float value)
         {
-            param2 = std::clamp(value, 0.0f, 1.0f);
+            param2.setTarget(std::clamp(value, 0.0f, 1.0f));
         }
 
         void setParam3(float value)
         {
-            param3 = std::clamp(value, 0.0f, 1.0f);
+            param3.setTarget(std::clamp(value, 0.0f, 1.0f));
         }
 
         void setWavefoldAmount(float value)
         {
-            wavefoldAmount = std::clamp(value, 0.0f, 1.0f);
+            wavefoldAmount.setTarget(std::clamp(value, 0.0f, 1.0f));
+        }
+
+        // Unison copies of the oscillator: 1 to OscillatorModule::kMaxUnisonVoices, taken from
+        // the rounded value. Detune and spread are 0..1 of the oscillator's maximum.
+        void setUnisonVoices(float value)
+        {
+            unisonVoices = static_cast<int>(std::lround(value));
+            oscillator.setUnison(unisonVoices, unisonDetune, unisonSpread);
+        }
+
+        void setUnisonDetune(float value)
+        {
+            unisonDetune = std::clamp(value, 0.0f, 1.0f);
+            oscillator.setUnison(unisonVoices, unisonDetune, unisonSpread);
+        }
+
+        void setUnisonSpread(float value)
+        {
+            unisonSpread = std::clamp(value, 0.0f, 1.0f);
+            oscillator.setUnison(unisonVoices, unisonDetune, unisonSpread);
         }
 
         void setAttack(float value)
@@ -145,165 +195,429 @@ namespace flues::disyn
 
         void setReverbSize(float value)
         {
-            reverbLeft.setSize(value);
-            reverbRight.setSize(value);
+            reverb.setSize(value);
         }
 
         void setReverbLevel(float value)
         {
-            reverbLeft.setLevel(value);
-            reverbRight.setLevel(value);
+            reverb.setLevel(value);
+        }
+
+        // When set, a new note rings on over the previous note's reverb tail instead of
+        // silencing it.
+        void setReverbKeepTail(bool keep)
+        {
+            keepReverbTail = keep;
         }
 
         void setMasterGain(float value)
         {
-            masterGain = std::clamp(value, 0.0f, 1.0f);
+            masterGain.setTarget(std::clamp(value, 0.0f, 1.0f));
         }
 
+        // Back stage state: in pipelined use, ask from the core that calls renderBack().
         bool getIsPlaying() const
         {
             return isPlaying;
         }
 
     private:
-        static float getAlgorithmFoldGain(AlgorithmType type)
+        // The chain is split into a front stage (events, oscillator, fold gain, wavefolder and
+        // their ramps) and a back stage (envelope, velocity, output and master gain, reverb,
+        // tail detection). Front and Back select which stages a call runs; processBlock runs
+        // both, chunk by chunk, in the original order. The stages share no mutable state: the
+        // back's note-stop report reaches the front through StageBlock::stopNote, or directly
+        // when both run together.
+        template <bool Front, bool Back, std::size_t Capacity>
+        void render(const EventQueue<Capacity> &list, float *left, float *right, int frames)
+        {
+            std::size_t next = 0;
+            int offset = 0;
+            while (offset < frames)
+            {
+                while (next < list.size() && list[next].frame <= offset)
+                {
+                    applyEvent<Front, Back>(list[next++]);
+                }
+                const int end = next < list.size() ? std::min(list[next].frame, frames) : frames;
+                renderSegment<Front, Back>(left + offset, right + offset, end - offset);
+                offset = end;
+            }
+            while (next < list.size())
+            {
+                applyEvent<Front, Back>(list[next++]);
+            }
+        }
+
+        // Renders one stretch with no pending events, in chunks of at most kMaxBlockSize frames.
+        // Parameter changes made since the previous segment ramp linearly across this one.
+        template <bool Front, bool Back>
+        void renderSegment(float *left, float *right, int frames)
+        {
+            if constexpr (Front)
+            {
+                beginFrontRamps(frames);
+            }
+            if constexpr (Back)
+            {
+                masterGain.begin(frames);
+            }
+            while (frames > 0)
+            {
+                const int chunk = std::min(frames, kMaxBlockSize);
+                if constexpr (Front)
+                {
+                    if (frontActive<Back>())
+                    {
+                        renderFrontChunk(left, right, chunk);
+                    }
+                    else
+                    {
+                        advanceFrontRamps(chunk);
+                        std::fill(left, left + chunk, 0.0f);
+                        std::fill(right, right + chunk, 0.0f);
+                    }
+                }
+                if constexpr (Back)
+                {
+                    if (isPlaying)
+                    {
+                        renderBackChunk(left, right, chunk);
+                    }
+                    else
+                    {
+                        masterGain.advance(chunk);
+                        std::fill(left, left + chunk, 0.0f);
+                        std::fill(right, right + chunk, 0.0f);
+                    }
+                }
+                left += chunk;
+                right += chunk;
+                frames -= chunk;
+            }
+            if constexpr (Front)
+            {
+                finishFrontRamps();
+            }
+            if constexpr (Back)
+            {
+                masterGain.finish();
+            }
+        }
+
+        // The front renders while a note may be sounding: until the back reports that the voice
+        // stopped after the latest note-on. A stale report only costs a block the back discards.
+        template <bool Back>
+        bool frontActive() const
+        {
+            return (Back ? stopNote : frontStopNote) != noteCount;
+        }
+
+        template <bool Front, bool Back>
+        void applyEvent(const EngineEvent &event)
+        {
+            switch (event.type)
+            {
+            case EngineEvent::Type::NOTE_ON:
+                if constexpr (Front)
+                {
+                    frontNoteOn(event.value);
+                }
+                if constexpr (Back)
+                {
+                    backNoteOn(event.value2);
+                }
+                break;
+            case EngineEvent::Type::NOTE_OFF:
+                if constexpr (Back)
+                {
+                    noteOff();
+                }
+                break;
+            case EngineEvent::Type::SET_PARAM:
+                setStageParameter<Front, Back>(event.param, event.value);
+                break;
+            }
+        }
+
+        template <bool Front, bool Back>
+        void setStageParameter(EngineParam param, float value)
+        {
+            switch (param)
+            {
+            case EngineParam::ALGORITHM:
+                selectAlgorithm<Front, Back>(static_cast<int>(std::lround(value)));
+                break;
+            case EngineParam::FREQUENCY:
+                if constexpr (Front)
+                {
+                    setFrequency(value);
+                }
+                break;
+            case EngineParam::PARAM_1:
+                if constexpr (Front)
+                {
+                    setParam1(value);
+                }
+                break;
+            case EngineParam::PARAM_2:
+                if constexpr (Front)
+                {
+                    setParam2(value);
+                }
+                break;
+            case EngineParam::PARAM_3:
+                if constexpr (Front)
+                {
+                    setParam3(value);
+                }
+                break;
+            case EngineParam::WAVEFOLD_AMOUNT:
+                if constexpr (Front)
+                {
+                    setWavefoldAmount(value);
+                }
+                break;
+            case EngineParam::UNISON_VOICES:
+                if constexpr (Front)
+                {
+                    setUnisonVoices(value);
+                }
+                break;
+            case EngineParam::UNISON_DETUNE:
+                if constexpr (Front)
+                {
+                    setUnisonDetune(value);
+                }
+                break;
+            case EngineParam::UNISON_SPREAD:
+                if constexpr (Front)
+                {
+                    setUnisonSpread(value);
+                }
+                break;
+            case EngineParam::ATTACK:
+                if constexpr (Back)
+                {
+                    setAttack(value);
+                }
+                break;
+            case EngineParam::RELEASE:
+                if constexpr (Back)
+                {
+                    setRelease(value);
+                }
+                break;
+            case EngineParam::REVERB_SIZE:
+                if constexpr (Back)
+                {
+                    setReverbSize(value);
+                }
+                break;
+            case EngineParam::REVERB_LEVEL:
+                if constexpr (Back)
+                {
+                    setReverbLevel(value);
+                }
+                break;
+            case EngineParam::MASTER_GAIN:
+                if constexpr (Back)
+                {
+                    setMasterGain(value);
+                }
+                break;
+            }
+        }
+
+        template <bool Front, bool Back>
+        void selectAlgorithm(int type)
+        {
+            if (!isValidAlgorithm(type))
+            {
+                return;
+            }
+            const AlgorithmType next = static_cast<AlgorithmType>(type);
+            if constexpr (Front)
+            {
+                if (next != algorithmType)
+                {
+                    algorithmType = next;
+                    // Start the newly selected algorithm clean, as a note-on would.
+                    oscillator.reset(algorithmType);
+                }
+            }
+            if constexpr (Back)
+            {
+                backAlgorithm = next;
+            }
+        }
+
+        void frontNoteOn(float freq)
+        {
+            frequency.snap(freq);
+            oscillator.reset(algorithmType);
+            ++noteCount;
+            // A new note starts on its settings instead of gliding from the previous ones.
+            finishFrontRamps();
+        }
+
+        void backNoteOn(float vel)
+        {
+            velocity = std::clamp(vel, 0.0f, 1.0f);
+            gate = true;
+            isPlaying = true;
+            ++backNoteCount;
+
+            envelope.reset();
+            if (!keepReverbTail)
+            {
+                reverb.reset();
+            }
+            masterGain.finish();
+
+            envelope.setGate(true);
+        }
+
+        void renderFrontChunk(float *left, float *right, int frames)
         {
-            switch (type)
+            // Generate oscillator block straight into the output buffers
+            renderOscillator(left, right, frames);
+
+            const float foldGain = algorithmDescriptor(algorithmType).foldGain();
+            for (int i = 0; i < frames; ++i)
             {
-            case AlgorithmType::DIRICHLET_PULSE:
-                return 0.901067f;
-            case AlgorithmType::DSF_SINGLE:
-                return 0.2450f;
-            case AlgorithmType::DSF_DOUBLE:
-                return 0.03480f;
-            case AlgorithmType::TANH_SQUARE:
-                return 0.10000f;
-            case AlgorithmType::TANH_SAW:
-                return 0.2000f;
-            case AlgorithmType::PAF:
-                return 0.01000f;
-            case AlgorithmType::MOD_FM:
-                return 0.01000f;
-            case AlgorithmType::COMBINATION_1_HYBRID_FORMANT:
-                return 0.0500f;
-            case AlgorithmType::COMBINATION_2_CASCADED:
-                return 0.01000f;
-            case AlgorithmType::COMBINATION_3_PARALLEL_BANK:
-                return 0.01000f;
-            case AlgorithmType::COMBINATION_4_FEEDBACK:
-                return 0.1000f;
-            case AlgorithmType::COMBINATION_5_MORPHING:
-                return 0.01000f;
-            case AlgorithmType::COMBINATION_6_INHARMONIC:
-                return 1.0000f;
-            case AlgorithmType::COMBINATION_7_ADAPTIVE_FILTER:
-                return 0.00040f;
-            case AlgorithmType::NOVEL_1_MULTISTAGE:
-                return 0.00355f;
-            case AlgorithmType::NOVEL_2_FREQ_ASYMMETRY:
-                return 0.000699f;
-            case AlgorithmType::NOVEL_3_CROSS_MOD:
-                return 0.01000f;
-            case AlgorithmType::NOVEL_4_TAYLOR:
-                return 1.0000f;
-            case AlgorithmType::TRAJECTORY:
-                return 1.0000f;
-            case AlgorithmType::SINE:
-                return 1.0000f;
-            case AlgorithmType::RAMP:
-                return 1.0000f;
-            case AlgorithmType::TRIANGLE:
-                return 1.0000f;
-            case AlgorithmType::PULSE:
-                return 1.0000f;
-            case AlgorithmType::NOISE:
-                return 1.0000f;
-            case AlgorithmType::LOGISTIC:
-                return 1.0000f;
-            case AlgorithmType::BUTTERFLY:
-                return 1.0000f;
-            default:
-                return 1.0f;
+                left[i] *= foldGain;
+                right[i] *= foldGain;
             }
+            if (wavefoldAmount.isRamping())
+            {
+                for (int i = 0; i < frames; ++i)
+                {
+                    foldAmountBuffer[i] = wavefoldAmount.next();
+                }
+                wavefolder.processBlock(left, frames, foldAmountBuffer);
+                wavefolder.processBlock(right, frames, foldAmountBuffer);
+            }
+            else
+            {
+                wavefolder.processBlock(left, frames, wavefoldAmount.value());
+                wavefolder.processBlock(right, frames, wavefoldAmount.value());
+            }
+            // Prev tune: postGain 3.0 with tanh. Reverting to avoid global distortion.
         }
 
-        static float getAlgorithmOutputGain(AlgorithmType type)
+        void renderBackChunk(float *left, float *right, int frames)
         {
-            switch (type)
+            // Apply envelope, velocity and master gain
+            envelope.processBlock(envelopeBuffer, frames);
+            const float gain = velocity * algorithmDescriptor(backAlgorithm).outputGain();
+            for (int i = 0; i < frames; ++i)
+            {
+                const float level = envelopeBuffer[i] * masterGain.next() * gain;
+                left[i] *= level;
+                right[i] *= level;
+            }
+
+            // Apply reverb
+            reverb.processBlock(left, right, frames);
+
+            // Voice tail detection - stop at the first silent frame once the envelope has finished
+            if (!envelope.isPlaying())
             {
-            case AlgorithmType::DIRICHLET_PULSE:
-                return 0.4721f;
-            case AlgorithmType::DSF_SINGLE:
-                return 1.0000f;
-            case AlgorithmType::DSF_DOUBLE:
-                return 1.0000f;
-            case AlgorithmType::TANH_SQUARE:
-                return 0.20f;
-            case AlgorithmType::TANH_SAW:
-                return 0.4991f;
-            case AlgorithmType::PAF:
-                return 0.80f;
-            case AlgorithmType::MOD_FM:
-                return 0.60f;
-            case AlgorithmType::COMBINATION_1_HYBRID_FORMANT:
-                return 1.0f;
-            case AlgorithmType::COMBINATION_2_CASCADED:
-                return 0.40f;
-            case AlgorithmType::COMBINATION_3_PARALLEL_BANK:
-                return 0.60f;
-            case AlgorithmType::COMBINATION_4_FEEDBACK:
-                return 0.8208f;
-            case AlgorithmType::COMBINATION_5_MORPHING:
-                return 0.50f;
-            case AlgorithmType::COMBINATION_6_INHARMONIC:
-                return 0.7967f;
-            case AlgorithmType::COMBINATION_7_ADAPTIVE_FILTER:
-                return 0.500f;
-            case AlgorithmType::NOVEL_1_MULTISTAGE:
-                return 0.40f;
-            case AlgorithmType::NOVEL_2_FREQ_ASYMMETRY:
-                return 0.50f;
-            case AlgorithmType::NOVEL_3_CROSS_MOD:
-                return 0.9917f;
-            case AlgorithmType::NOVEL_4_TAYLOR:
-                return 0.4501f;
-            case AlgorithmType::TRAJECTORY:
-                return 0.6886f;
-            case AlgorithmType::SINE:
-                return 0.8f;
-            case AlgorithmType::RAMP:
-                return 0.8f;
-            case AlgorithmType::TRIANGLE:
-                return 0.8f;
-            case AlgorithmType::PULSE:
-                return 0.8f;
-            case AlgorithmType::NOISE:
-                return 0.6f;
-            case AlgorithmType::LOGISTIC:
-                return 0.6f;
-            case AlgorithmType::BUTTERFLY:
-                return 0.6f;
-            default:
-                return 1.0f;
+                for (int i = 0; i < frames; ++i)
+                {
+                    if (envelopeBuffer[i] <= 0.0f &&
+                        std::max(std::abs(left[i]), std::abs(right[i])) < 1e-5f)
+                    {
+                        isPlaying = false;
+                        stopNote = backNoteCount;
+                        std::fill(left + i + 1, left + frames, 0.0f);
+                        std::fill(right + i + 1, right + frames, 0.0f);
+                        break;
+                    }
+                }
             }
         }
+
+        // The algorithms map their parameters once per prepare(), so while pitch or a param is
+        // ramping the chunk is split into control blocks; otherwise it renders in one call.
+        void renderOscillator(float *left, float *right, int frames)
+        {
+            if (!frequency.isRamping() && !param1.isRamping() && !param2.isRamping() &&
+                !param3.isRamping())
+            {
+                oscillator.processBlock(algorithmType, frequency.value(), param1.value(), param2.value(),
+                                        param3.value(), left, right, frames);
+                return;
+            }
+
+            for (int offset = 0; offset < frames; offset += kControlBlockSize)
+            {
+                const int count = std::min(kControlBlockSize, frames - offset);
+                oscillator.processBlock(algorithmType, frequency.advance(count), param1.advance(count),
+                                        param2.advance(count), param3.advance(count),
+                                        left + offset, right + offset, count);
+            }
+        }
+
+        void beginFrontRamps(int frames)
+        {
+            frequency.begin(frames);
+            param1.begin(frames);
+            param2.begin(frames);
+            param3.begin(frames);
+            wavefoldAmount.begin(frames);
+        }
+
+        void advanceFrontRamps(int frames)
+        {
+            frequency.advance(frames);
+            param1.advance(frames);
+            param2.advance(frames);
+            param3.advance(frames);
+            wavefoldAmount.advance(frames);
+        }
+
+        void finishFrontRamps()
+        {
+            frequency.finish();
+            param1.finish();
+            param2.finish();
+            param3.finish();
+            wavefoldAmount.finish();
+        }
+
         float sampleRate;
+
+        // Front stage
         OscillatorModule oscillator;
         WavefolderModule wavefolder;
-        EnvelopeModule envelope;
-        ReverbModule reverbLeft;
-        ReverbModule reverbRight;
-
-        float frequency;
+        ParameterRamp frequency;
         AlgorithmType algorithmType;
-        float param1;
-        float param2;
-        float param3;
-        float wavefoldAmount;
-        float masterGain;
+        ParameterRamp param1;
+        ParameterRamp param2;
+        ParameterRamp param3;
+        ParameterRamp wavefoldAmount;
+        int unisonVoices = 1;
+        float unisonDetune = 0.0f;
+        float unisonSpread = 0.0f;
+        uint32_t noteCount = 0;
+        uint32_t frontStopNote = 0;
+        EventQueue<kMaxEvents> events;
+        float foldAmountBuffer[kMaxBlockSize];
+
+        // Back stage
+        EnvelopeModule envelope;
+        ReverbModule reverb;
+        AlgorithmType backAlgorithm;
+        ParameterRamp masterGain;
         float velocity;
         bool gate;
         bool isPlaying;
+        bool keepReverbTail;
+        uint32_t backNoteCount = 0;
+        uint32_t stopNote = 0; // backNoteCount when the voice last went silent
+        float envelopeBuffer[kMaxBlockSize];
     };
 
 } // namespace flues::disyn
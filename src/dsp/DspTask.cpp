@@ -1,5 +1,6 @@
 #include "dsp/DspTask.h"
 
+#include <atomic>
 #include <cstring>
 #include <cmath>
 #include <algorithm>
@@ -24,18 +25,20 @@ static float effectiveParam2 = 0.0f;
 static flues::disyn::DisynEngine engine{kSampleRate};
 static float wavefoldAmount = 0.0f;
 static bool lastGate = false;
-static float smoothPitch = 0.0f;
 static float testPhase = 0.0f;
 static uint8_t lastAlgorithm = 0;
 constexpr int kAudioBlockSize = 64;
 static uint16_t audioBlock[kAudioBlockSize * 2] = {};
+static float leftBlock[kAudioBlockSize] = {};
+static float rightBlock[kAudioBlockSize] = {};
 static uint32_t underrunCount = 0;
 static float outputGain = 0.8f;
 static bool audioOk = true;
+static disyn::ScopeCapture scope{disyn::gScopeMailbox};
 
 static float softClip(float value)
 {
-    return std::tanh(value);
+    return flues::disyn::fastTanh(value);
 }
 
 static float clamp01(float value)
@@ -69,11 +72,6 @@ static float clamp(float value, float minValue, float maxValue)
     return value;
 }
 
-static float smoothValue(float current, float target, float alpha)
-{
-    return current + alpha * (target - current);
-}
-
 static uint16_t sampleToDac(float sample)
 {
     float normalized = sample * 0.5f + 0.5f;
@@ -81,7 +79,7 @@ static uint16_t sampleToDac(float sample)
     return static_cast<uint16_t>(normalized * 255.0f) << 8;
 }
 
-static void Init()
+void Init()
 {
     Serial.println("DSP: init start");
     gate.begin(kPinGateIn, kPinGateOut);
@@ -93,16 +91,30 @@ static void Init()
     Serial.println("DSP: init done");
 }
 
-static void Tick()
+// Everything one audio block needs besides the engine's output. In pipelined mode it travels
+// with the block, so the back stage never reads the front stage's state.
+struct BlockControls
+{
+    bool isTest;
+    bool engineGate;
+    bool restartTest;
+    float outputGain;
+    float testParam1;
+    float testParam2;
+    disyn::ScopeSource scopeSource;
+    uint16_t scopeDecimation;
+    float cv0;
+    float cv1;
+    float pitchCv;
+};
+
+// Reads pending parameters and the gate, and schedules this block's engine changes.
+static BlockControls updateControls()
 {
-    // TODO: run audio processing at the configured sample rate.
-    if (disyn::gParamQueue != nullptr)
+    disyn::ParamMessage message{};
+    if (disyn::gParamMailbox.receive(message))
     {
-        disyn::ParamMessage message{};
-        if (xQueueReceive(disyn::gParamQueue, &message, 0) == pdTRUE)
-        {
-            params = message.params;
-        }
+        params = message.params;
     }
 
     bool gateHigh = gate.read();
@@ -140,11 +152,12 @@ static void Tick()
     bool forceContinuous = params.attack <= 0.0f && params.decay <= 0.0f;
     bool engineGate = gateHigh || forceContinuous;
     bool isTest = params.algorithm == disyn::kTestAlgorithmIndex;
+    bool restartTest = false;
 
     if (params.algorithm != lastAlgorithm)
     {
         lastGate = false;
-        testPhase = 0.0f;
+        restartTest = true;
         lastAlgorithm = params.algorithm;
     }
 
@@ -155,50 +168,77 @@ static void Tick()
     float masterGain = clamp01(params.masterGain + (params.cv2 - 0.5f) * kMasterCvAmount +
                                (params.pot2 - 0.5f) * kMasterPotAmount);
 
+    // Scheduled at frame 0 rather than set directly, so that in pipelined mode each change
+    // reaches both stages on the same block.
+    using flues::disyn::EngineParam;
     if (!isTest)
     {
-        engine.setAlgorithm(params.algorithm);
-        engine.setParam1(effectiveParam1);
-        engine.setParam2(effectiveParam2);
-        engine.setWavefoldAmount(wavefoldAmount);
-        engine.setAttack(params.attack);
-        engine.setRelease(params.decay);
-        engine.setReverbSize(reverbSize);
-        engine.setReverbLevel(reverbLevel);
-        engine.setMasterGain(masterGain);
-        engine.setFrequency(frequency);
+        engine.scheduleParameter(0, EngineParam::ALGORITHM, params.algorithm);
+        engine.scheduleParameter(0, EngineParam::PARAM_1, effectiveParam1);
+        engine.scheduleParameter(0, EngineParam::PARAM_2, effectiveParam2);
+        engine.scheduleParameter(0, EngineParam::WAVEFOLD_AMOUNT, wavefoldAmount);
+        engine.scheduleParameter(0, EngineParam::ATTACK, params.attack);
+        engine.scheduleParameter(0, EngineParam::RELEASE, params.decay);
+        engine.scheduleParameter(0, EngineParam::REVERB_SIZE, reverbSize);
+        engine.scheduleParameter(0, EngineParam::REVERB_LEVEL, reverbLevel);
+        engine.scheduleParameter(0, EngineParam::MASTER_GAIN, masterGain);
+        engine.scheduleParameter(0, EngineParam::FREQUENCY, frequency);
 
         if (engineGate && !lastGate)
         {
-            engine.noteOn(frequency, 1.0f);
+            engine.scheduleNoteOn(0, frequency, 1.0f);
         }
         else if (!engineGate && lastGate)
         {
-            engine.noteOff();
+            engine.scheduleNoteOff(0);
         }
     }
     lastGate = engineGate;
 
-    const float scopeValue = pitchCv;
+    BlockControls controls{};
+    controls.isTest = isTest;
+    controls.engineGate = engineGate;
+    controls.restartTest = restartTest;
+    controls.outputGain = masterGain;
+    controls.testParam1 = effectiveParam1;
+    controls.testParam2 = effectiveParam2;
+    controls.scopeSource = static_cast<disyn::ScopeSource>(params.scopeSource);
+    controls.scopeDecimation = params.scopeDecimation;
+    controls.cv0 = params.cv0;
+    controls.cv1 = params.cv1;
+    controls.pitchCv = pitchCv;
+    return controls;
+}
+
+// Turns the engine's output in leftBlock/rightBlock (or the test tone) into DAC words, feeds
+// the scope and gate output, and writes the block to the audio output.
+static void finishBlock(const BlockControls &controls)
+{
+    const bool isTest = controls.isTest;
+    const bool engineGate = controls.engineGate;
+    if (controls.restartTest)
+    {
+        testPhase = 0.0f;
+    }
+    outputGain = controls.outputGain;
+
     for (int i = 0; i < kAudioBlockSize; ++i)
     {
         float leftSample = 0.0f;
         float rightSample = 0.0f;
-        outputGain = masterGain;
 
         if (isTest)
         {
             const auto &info = disyn::GetAlgorithmInfo(disyn::kTestAlgorithmIndex);
-            float testFreq = disyn::MapNormalized(info.param1, effectiveParam1);
-            float testLevel = disyn::MapNormalized(info.param2, effectiveParam2);
+            float testFreq = disyn::MapNormalized(info.param1, controls.testParam1);
+            float testLevel = disyn::MapNormalized(info.param2, controls.testParam2);
             float phaseStep = testFreq / static_cast<float>(kSampleRate);
             testPhase += phaseStep;
             if (testPhase >= 1.0f)
             {
                 testPhase -= 1.0f;
             }
-            constexpr float kTwoPi = 6.283185307179586f;
-            float tone = std::sin(testPhase * kTwoPi);
+            float tone = flues::disyn::sinePhase(testPhase);
             float gateLevel = engineGate ? 1.0f : 0.0f;
             float sampleValue = tone * testLevel * gateLevel;
             leftSample = softClip(sampleValue * outputGain);
@@ -206,15 +246,14 @@ static void Tick()
         }
         else
         {
-            auto sample = engine.process();
-            float primary = sample.primary;
-            float secondary = sample.secondary;
+            float primary = leftBlock[i];
+            float secondary = rightBlock[i];
             primary = clamp(primary, -kSampleGuardLimit, kSampleGuardLimit);
             secondary = clamp(secondary, -kSampleGuardLimit, kSampleGuardLimit);
             if (kPreClipTanhDrive > 0.0f)
             {
-                primary = std::tanh(primary * kPreClipTanhDrive);
-                secondary = std::tanh(secondary * kPreClipTanhDrive);
+                primary = flues::disyn::fastTanh(primary * kPreClipTanhDrive);
+                secondary = flues::disyn::fastTanh(secondary * kPreClipTanhDrive);
             }
             leftSample = softClip(primary * outputGain * kGlobalPreGain);
             rightSample = softClip(secondary * outputGain * kGlobalPreGain);
@@ -223,9 +262,29 @@ static void Tick()
         uint16_t right = sampleToDac(rightSample);
         audioBlock[i * 2] = left;
         audioBlock[i * 2 + 1] = right;
+        // Keep the final output for the scope; the engine's block is no longer needed.
+        leftBlock[i] = leftSample;
+        rightBlock[i] = rightSample;
+    }
 
-        disyn::gScopeBuffer[disyn::gScopeIndex] = scopeValue;
-        disyn::gScopeIndex = (disyn::gScopeIndex + 1) % disyn::kScopeSize;
+    scope.configure(controls.scopeSource, controls.scopeDecimation);
+    switch (scope.selectedSource())
+    {
+    case disyn::ScopeSource::OUTPUT_LEFT:
+        scope.capture(leftBlock, kAudioBlockSize);
+        break;
+    case disyn::ScopeSource::OUTPUT_RIGHT:
+        scope.capture(rightBlock, kAudioBlockSize);
+        break;
+    case disyn::ScopeSource::CV0:
+        scope.captureConstant(controls.cv0, kAudioBlockSize);
+        break;
+    case disyn::ScopeSource::CV1:
+        scope.captureConstant(controls.cv1, kAudioBlockSize);
+        break;
+    default:
+        scope.captureConstant(controls.pitchCv, kAudioBlockSize);
+        break;
     }
 
     bool soundPlaying = engine.getIsPlaying();
@@ -245,15 +304,97 @@ static void Tick()
         ++underrunCount;
     }
 
-    if (disyn::gStatusQueue != nullptr)
+    disyn::StatusMessage status{};
+    status.underruns = underrunCount;
+    status.audioOk = audioOk;
+    disyn::gStatusMailbox.publish(status);
+}
+
+void Tick()
+{
+    const BlockControls controls = updateControls();
+    if (!controls.isTest)
+    {
+        engine.processBlock(leftBlock, rightBlock, kAudioBlockSize);
+    }
+    finishBlock(controls);
+}
+
+#if DISYN_PIPELINED
+
+struct PipelineBlock
+{
+    BlockControls controls;
+    flues::disyn::DisynEngine::StageBlock stage;
+};
+
+// Front stage to back stage. With two slots the front renders block N while the back
+// finishes block N-1; each side sleeps on a task notification when it has to wait.
+static disyn::BlockQueue<PipelineBlock, 2> pipeline;
+static std::atomic<TaskHandle_t> frontTask{nullptr};
+static std::atomic<TaskHandle_t> backTask{nullptr};
+// Upper bound on a wait, in case a notification was sent before the handle was known.
+constexpr TickType_t kPipelineWait = pdMS_TO_TICKS(2);
+
+static void wake(const std::atomic<TaskHandle_t> &task)
+{
+    TaskHandle_t handle = task.load(std::memory_order_acquire);
+    if (handle != nullptr)
     {
-        disyn::StatusMessage status{};
-        status.underruns = underrunCount;
-        status.audioOk = audioOk;
-        xQueueOverwrite(disyn::gStatusQueue, &status);
+        xTaskNotifyGive(handle);
     }
 }
 
+void FrontTick()
+{
+    frontTask.store(xTaskGetCurrentTaskHandle(), std::memory_order_release);
+    PipelineBlock *block = nullptr;
+    while ((block = pipeline.acquireSlot()) == nullptr)
+    {
+        ulTaskNotifyTake(pdTRUE, kPipelineWait);
+    }
+
+    block->controls = updateControls();
+    if (!block->controls.isTest)
+    {
+        engine.renderFront(block->stage, kAudioBlockSize);
+    }
+    pipeline.push();
+    wake(backTask);
+}
+
+void BackTick()
+{
+    PipelineBlock *block = nullptr;
+    while ((block = pipeline.frontSlot()) == nullptr)
+    {
+        ulTaskNotifyTake(pdTRUE, kPipelineWait);
+    }
+
+    const BlockControls controls = block->controls;
+    if (!controls.isTest)
+    {
+        engine.renderBack(block->stage, leftBlock, rightBlock);
+    }
+    // Free the slot before the DAC conversion and write, so the front can start the next block.
+    pipeline.pop();
+    wake(frontTask);
+    finishBlock(controls);
+}
+
+void BackTask(void *parameters)
+{
+    (void)parameters;
+    backTask.store(xTaskGetCurrentTaskHandle(), std::memory_order_release);
+
+    for (;;)
+    {
+        BackTick();
+    }
+}
+
+#endif
+
 void Task(void *parameters)
 {
     (void)parameters;
@@ -261,7 +402,11 @@ void Task(void *parameters)
 
     for (;;)
     {
+#if DISYN_PIPELINED
+        FrontTick();
+#else
         Tick();
+#endif
     }
 }
 
@@ -2,8 +2,28 @@
 
 #include <Arduino.h>
 
+#include "Config.h"
+
 namespace disyn::dsp {
 
+// Sets up the gate and audio output.
+void Init();
+
+// Reads pending parameters, renders one audio block and writes it to the audio output.
+void Tick();
+
+// FreeRTOS entry point: Init() once, then Tick() forever, or FrontTick() when pipelined.
 void Task(void *parameters);
 
+#if DISYN_PIPELINED
+// Pipelined mode: FrontTick() reads parameters and renders the oscillator and wavefolder for
+// one block; BackTick(), on the other core, runs the envelope and reverb on the previous
+// block and writes it to the audio output. Each waits while the other is a block behind.
+void FrontTick();
+void BackTick();
+
+// FreeRTOS entry point for the back stage: BackTick() forever. Start it after Task().
+void BackTask(void *parameters);
+#endif
+
 } // namespace disyn::dsp
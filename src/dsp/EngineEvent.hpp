@@ -0,0 +1,99 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace flues::disyn
+{
+
+    enum class EngineParam : uint8_t
+    {
+        ALGORITHM,
+        FREQUENCY,
+        PARAM_1,
+        PARAM_2,
+        PARAM_3,
+        WAVEFOLD_AMOUNT,
+        ATTACK,
+        RELEASE,
+        REVERB_SIZE,
+        REVERB_LEVEL,
+        MASTER_GAIN,
+        UNISON_VOICES, // 1..8 copies, rounded
+        UNISON_DETUNE,
+        UNISON_SPREAD
+    };
+
+    // A note or parameter change that takes effect frame samples into the next render call.
+    struct EngineEvent
+    {
+        enum class Type : uint8_t
+        {
+            NOTE_ON,
+            NOTE_OFF,
+            SET_PARAM
+        };
+
+        int frame;
+        Type type;
+        EngineParam param;
+        float value;  // note-on frequency or parameter value
+        float value2; // note-on velocity
+    };
+
+    // Fixed-capacity event list kept ordered by frame; events on the same frame stay in the
+    // order they were pushed. No allocation, so hosts may fill it from the audio thread.
+    template <std::size_t Capacity>
+    class EventQueue
+    {
+    public:
+        // Returns false and drops the event when the queue is full.
+        bool push(const EngineEvent &event)
+        {
+            if (count == Capacity)
+            {
+                return false;
+            }
+
+            EngineEvent entry = event;
+            entry.frame = std::max(entry.frame, 0);
+
+            std::size_t index = count;
+            while (index > 0 && events[index - 1].frame > entry.frame)
+            {
+                events[index] = events[index - 1];
+                --index;
+            }
+            events[index] = entry;
+            ++count;
+            return true;
+        }
+
+        void clear()
+        {
+            count = 0;
+        }
+
+        bool empty() const
+        {
+            return count == 0;
+        }
+
+        std::size_t size() const
+        {
+            return count;
+        }
+
+        const EngineEvent &operator[](std::size_t index) const
+        {
+            return events[index];
+        }
+
+    private:
+        std::array<EngineEvent, Capacity> events{};
+        std::size_t count = 0;
+    };
+
+} // namespace flues::disyn
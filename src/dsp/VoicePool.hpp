@@ -0,0 +1,533 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#include "algorithms/AlgorithmRegistry.hpp"
+#include "algorithms/AlgorithmTypes.hpp"
+#include "modules/EnvelopeModule.hpp"
+#include "modules/OscillatorModule.hpp"
+#include "modules/ParameterRamp.hpp"
+#include "modules/ReverbModule.hpp"
+#include "modules/WavefolderModule.hpp"
+
+namespace flues::disyn
+{
+
+    // Polyphonic counterpart of DisynEngine: up to Voices notes at once, all playing the same
+    // algorithm and settings. Each voice owns only what differs between notes, its oscillator
+    // state, pitch, velocity and envelope level; the parameter ramps, wavefolder, envelope
+    // rates, master gain and reverb are shared, so a voice costs an oscillator, not an engine.
+    // Voice state is kept as one array per field. Algorithms with a lane kernel (see
+    // OscillatorModule::hasLaneKernel) keep only a phase, increment and slew per voice and
+    // render every voice in one loop through coefficients prepared once; the others keep an
+    // OscillatorModule per voice. Voice buffers are interleaved, frame i of voice v at
+    // [i * Voices + v], so the fold gain, wavefolder, envelope and mix also run with voices
+    // as the inner index. With one voice the output matches DisynEngine driven by the same
+    // calls, except that the reverb is a send shared by all voices and is only cleared when
+    // the pool falls silent, and a voice's oscillator stops with its envelope instead of
+    // running on through the reverb tail.
+    template <std::size_t Voices>
+    class VoicePool
+    {
+        static_assert(Voices > 0, "VoicePool needs at least one voice");
+
+    public:
+        static constexpr int kMaxBlockSize = 64;
+        // While oscillator controls ramp, the algorithms are re-prepared every this many frames.
+        static constexpr int kControlBlockSize = 16;
+        static constexpr int kNoVoice = -1;
+
+        explicit VoicePool(float sampleRate = 44100.0f)
+            : sampleRate(sampleRate),
+              kernelOscillator(sampleRate),
+              envelopeSettings(sampleRate),
+              reverb(sampleRate)
+        {
+            oscillators.fill(OscillatorModule(sampleRate));
+            frequency.fill(440.0f);
+            velocity.fill(1.0f);
+            level.fill(0.0f);
+            gate.fill(false);
+            active.fill(false);
+            note.fill(kNoVoice);
+            started.fill(0);
+        }
+
+        // Starts note on a voice and returns it. A note that is already sounding retriggers its
+        // voice; otherwise a free voice is used, and with none free a voice is stolen.
+        int noteOn(int noteId, float freq, float vel = 1.0f)
+        {
+            const bool wasSilent = !isPlaying;
+            const int voice = allocateVoice(noteId);
+
+            frequency[voice] = freq;
+            velocity[voice] = std::clamp(vel, 0.0f, 1.0f);
+            note[voice] = noteId;
+            started[voice] = ++noteCounter;
+            gate[voice] = true;
+            active[voice] = true;
+            isPlaying = true;
+
+            // As the algorithm's own reset and setFrequency would leave it.
+            voiceLanes.phase[voice] = 0u;
+            voiceLanes.increment[voice] = phaseFromCycles(freq / sampleRate);
+            voiceLanes.slewPrimary[voice] = 0.0f;
+            voiceLanes.slewSecondary[voice] = 0.0f;
+            oscillators[voice].reset(algorithmType);
+            level[voice] = 0.0f;
+            // Other voices may be sounding through the shared chain; only a note that starts
+            // from silence gets a clean reverb and settles the ramps, as DisynEngine::noteOn does.
+            if (wasSilent)
+            {
+                reverb.reset();
+                finishRamps();
+            }
+            return voice;
+        }
+
+        void noteOff(int noteId)
+        {
+            for (std::size_t v = 0; v < Voices; ++v)
+            {
+                if (note[v] == noteId)
+                {
+                    gate[v] = false;
+                }
+            }
+        }
+
+        void allNotesOff()
+        {
+            gate.fill(false);
+        }
+
+        // Renders frames of stereo output, in chunks of at most kMaxBlockSize frames. Parameter
+        // changes made since the previous call ramp linearly across this one.
+        void processBlock(float *left, float *right, int frames)
+        {
+            beginRamps(frames);
+            while (frames > 0)
+            {
+                const int chunk = std::min(frames, kMaxBlockSize);
+                if (isPlaying)
+                {
+                    renderChunk(left, right, chunk);
+                }
+                else
+                {
+                    advanceRamps(chunk);
+                    std::fill(left, left + chunk, 0.0f);
+                    std::fill(right, right + chunk, 0.0f);
+                }
+                left += chunk;
+                right += chunk;
+                frames -= chunk;
+            }
+            finishRamps();
+        }
+
+        // Parameter setters, shared by every voice
+        void setAlgorithm(int type)
+        {
+            if (!isValidAlgorithm(type))
+            {
+                return;
+            }
+            const AlgorithmType next = static_cast<AlgorithmType>(type);
+            if (next != algorithmType)
+            {
+                algorithmType = next;
+                // Start the newly selected algorithm clean, as a note-on would.
+                voiceLanes.phase.fill(0u);
+                voiceLanes.slewPrimary.fill(0.0f);
+                voiceLanes.slewSecondary.fill(0.0f);
+                for (OscillatorModule &oscillator : oscillators)
+                {
+                    oscillator.reset(algorithmType);
+                }
+            }
+        }
+
+        void setParam1(float value)
+        {
+            param1.setTarget(std::clamp(value, 0.0f, 1.0f));
+        }
+
+        void setParam2(float value)
+        {
+            param2.setTarget(std::clamp(value, 0.0f, 1.0f));
+        }
+
+        void setParam3(float value)
+        {
+            param3.setTarget(std::clamp(value, 0.0f, 1.0f));
+        }
+
+        void setWavefoldAmount(float value)
+        {
+            wavefoldAmount.setTarget(std::clamp(value, 0.0f, 1.0f));
+        }
+
+        void setAttack(float value)
+        {
+            envelopeSettings.setAttack(value);
+        }
+
+        void setRelease(float value)
+        {
+            envelopeSettings.setRelease(value);
+        }
+
+        void setReverbSize(float value)
+        {
+            reverb.setSize(value);
+        }
+
+        void setReverbLevel(float value)
+        {
+            reverb.setLevel(value);
+        }
+
+        void setMasterGain(float value)
+        {
+            masterGain.setTarget(std::clamp(value, 0.0f, 1.0f));
+        }
+
+        // True while any voice or the reverb tail is sounding.
+        bool getIsPlaying() const
+        {
+            return isPlaying;
+        }
+
+        int activeVoices() const
+        {
+            return static_cast<int>(std::count(active.begin(), active.end(), true));
+        }
+
+    private:
+        // Free voices first, then the quietest released voice, then the oldest held voice.
+        int allocateVoice(int noteId)
+        {
+            int chosen = kNoVoice;
+            for (std::size_t v = 0; v < Voices; ++v)
+            {
+                if (active[v] && note[v] == noteId)
+                {
+                    return static_cast<int>(v);
+                }
+                if (!active[v] && chosen == kNoVoice)
+                {
+                    chosen = static_cast<int>(v);
+                }
+            }
+            if (chosen != kNoVoice)
+            {
+                return chosen;
+            }
+
+            for (std::size_t v = 0; v < Voices; ++v)
+            {
+                if (gate[v])
+                {
+                    continue;
+                }
+                if (chosen == kNoVoice || level[v] < level[chosen] ||
+                    (level[v] == level[chosen] && started[v] < started[chosen]))
+                {
+                    chosen = static_cast<int>(v);
+                }
+            }
+            if (chosen != kNoVoice)
+            {
+                return chosen;
+            }
+
+            chosen = 0;
+            for (std::size_t v = 1; v < Voices; ++v)
+            {
+                if (started[v] < started[chosen])
+                {
+                    chosen = static_cast<int>(v);
+                }
+            }
+            return chosen;
+        }
+
+        void renderChunk(float *left, float *right, int frames)
+        {
+            // Controls shared by every voice, computed once for the chunk.
+            const bool foldRamping = wavefoldAmount.isRamping();
+            if (foldRamping)
+            {
+                for (int i = 0; i < frames; ++i)
+                {
+                    const float amount = wavefoldAmount.next();
+                    std::fill(foldAmountBuffer + i * Voices, foldAmountBuffer + (i + 1) * Voices, amount);
+                }
+            }
+            for (int i = 0; i < frames; ++i)
+            {
+                masterBuffer[i] = masterGain.next();
+            }
+            const int controlBlocks = prepareControls(frames);
+
+            bool voicesActive = false;
+            if (std::find(active.begin(), active.end(), true) == active.end())
+            {
+                std::fill(left, left + frames, 0.0f);
+                std::fill(right, right + frames, 0.0f);
+                std::fill(envelopeSum, envelopeSum + frames, 0.0f);
+            }
+            else
+            {
+                const AlgorithmDescriptor &descriptor = algorithmDescriptor(algorithmType);
+                const float foldGain = descriptor.foldGain();
+                const float outputGain = descriptor.outputGain();
+                const int samples = frames * static_cast<int>(Voices);
+
+                renderOscillators(controlBlocks, frames);
+                for (int n = 0; n < samples; ++n)
+                {
+                    voiceLeft[n] *= foldGain;
+                    voiceRight[n] *= foldGain;
+                }
+                if (foldRamping)
+                {
+                    wavefolder.processBlock(voiceLeft, samples, foldAmountBuffer);
+                    wavefolder.processBlock(voiceRight, samples, foldAmountBuffer);
+                }
+                else
+                {
+                    wavefolder.processBlock(voiceLeft, samples, wavefoldAmount.value());
+                    wavefolder.processBlock(voiceRight, samples, wavefoldAmount.value());
+                }
+
+                // Voices that finish during this chunk still sound up to the end of their release.
+                std::array<float, Voices> gain;
+                for (std::size_t v = 0; v < Voices; ++v)
+                {
+                    gain[v] = active[v] ? velocity[v] * outputGain : 0.0f;
+                }
+                voicesActive = renderEnvelopes(frames);
+
+                // The first voice sets each frame's sum and the rest add to it in voice order, so
+                // one voice is exactly DisynEngine's output.
+                for (int i = 0; i < frames; ++i)
+                {
+                    const float *frameLeft = voiceLeft + i * Voices;
+                    const float *frameRight = voiceRight + i * Voices;
+                    const float *frameEnvelope = envelopeBuffer + i * Voices;
+                    float voiceLevel = frameEnvelope[0] * masterBuffer[i] * gain[0];
+                    float sumLeft = frameLeft[0] * voiceLevel;
+                    float sumRight = frameRight[0] * voiceLevel;
+                    float sumEnvelope = frameEnvelope[0];
+                    for (std::size_t v = 1; v < Voices; ++v)
+                    {
+                        voiceLevel = frameEnvelope[v] * masterBuffer[i] * gain[v];
+                        sumLeft += frameLeft[v] * voiceLevel;
+                        sumRight += frameRight[v] * voiceLevel;
+                        sumEnvelope += frameEnvelope[v];
+                    }
+                    left[i] = sumLeft;
+                    right[i] = sumRight;
+                    envelopeSum[i] = sumEnvelope;
+                }
+            }
+
+            // Apply the shared reverb send
+            reverb.processBlock(left, right, frames);
+
+            // Tail detection - once every voice has finished, stop at the first silent frame
+            if (!voicesActive)
+            {
+                for (int i = 0; i < frames; ++i)
+                {
+                    if (envelopeSum[i] <= 0.0f && std::max(std::abs(left[i]), std::abs(right[i])) < 1e-5f)
+                    {
+                        isPlaying = false;
+                        std::fill(left + i + 1, left + frames, 0.0f);
+                        std::fill(right + i + 1, right + frames, 0.0f);
+                        break;
+                    }
+                }
+            }
+        }
+
+        // Fills the per-control-block parameter values for the chunk and returns how many
+        // control blocks it has: one when nothing ramps, as DisynEngine renders it.
+        int prepareControls(int frames)
+        {
+            if (!param1.isRamping() && !param2.isRamping() && !param3.isRamping())
+            {
+                controlParam1[0] = param1.value();
+                controlParam2[0] = param2.value();
+                controlParam3[0] = param3.value();
+                return 1;
+            }
+
+            int count = 0;
+            for (int offset = 0; offset < frames; offset += kControlBlockSize, ++count)
+            {
+                const int length = std::min(kControlBlockSize, frames - offset);
+                controlParam1[count] = param1.advance(length);
+                controlParam2[count] = param2.advance(length);
+                controlParam3[count] = param3.advance(length);
+            }
+            return count;
+        }
+
+        // Renders every voice into the interleaved voice buffers, re-preparing the algorithm
+        // once per control block. Voices that are not active render silence or are left to run
+        // on; their gain is zero in the mix.
+        void renderOscillators(int controlBlocks, int frames)
+        {
+            const int blockSize = controlBlocks == 1 ? frames : kControlBlockSize;
+            for (int block = 0; block < controlBlocks; ++block)
+            {
+                const int offset = block * blockSize;
+                const int count = std::min(blockSize, frames - offset);
+                float *blockLeft = voiceLeft + offset * Voices;
+                float *blockRight = voiceRight + offset * Voices;
+                if (kernelOscillator.processVoices(algorithmType, controlParam1[block], controlParam2[block],
+                                                   controlParam3[block], voiceLanes, blockLeft, blockRight, count))
+                {
+                    continue;
+                }
+
+                for (std::size_t v = 0; v < Voices; ++v)
+                {
+                    if (active[v])
+                    {
+                        oscillators[v].processBlock(algorithmType, frequency[v], controlParam1[block],
+                                                    controlParam2[block], controlParam3[block], scratchLeft,
+                                                    scratchRight, count);
+                    }
+                    else
+                    {
+                        std::fill(scratchLeft, scratchLeft + count, 0.0f);
+                        std::fill(scratchRight, scratchRight + count, 0.0f);
+                    }
+                    for (int i = 0; i < count; ++i)
+                    {
+                        blockLeft[i * Voices + v] = scratchLeft[i];
+                        blockRight[i * Voices + v] = scratchRight[i];
+                    }
+                }
+            }
+        }
+
+        // EnvelopeModule::step for every active voice at once, into the interleaved envelope
+        // buffer: each step adds the attack or subtracts the release and clamps to [0, 1], which
+        // gives the same levels. Returns whether any voice is still sounding.
+        bool renderEnvelopes(int frames)
+        {
+            const EnvelopeModule::Rates rates = envelopeSettings.rates();
+            std::array<float, Voices> delta;
+            for (std::size_t v = 0; v < Voices; ++v)
+            {
+                if (active[v] && rates.hold)
+                {
+                    level[v] = 1.0f;
+                }
+                delta[v] = !active[v] || rates.hold ? 0.0f : gate[v] ? rates.attack : -rates.release;
+            }
+
+            // A release that went below zero on the last step has finished; once at zero every
+            // later step goes below again, so the last step is enough to tell.
+            std::array<bool, Voices> finished{};
+            for (int i = 0; i < frames; ++i)
+            {
+                for (std::size_t v = 0; v < Voices; ++v)
+                {
+                    const float next = level[v] + delta[v];
+                    finished[v] = next < 0.0f;
+                    level[v] = std::clamp(next, 0.0f, 1.0f);
+                    envelopeBuffer[i * Voices + v] = level[v];
+                }
+            }
+
+            bool anyActive = false;
+            for (std::size_t v = 0; v < Voices; ++v)
+            {
+                active[v] = active[v] && !finished[v];
+                anyActive = anyActive || active[v];
+            }
+            return anyActive;
+        }
+
+        void beginRamps(int frames)
+        {
+            param1.begin(frames);
+            param2.begin(frames);
+            param3.begin(frames);
+            wavefoldAmount.begin(frames);
+            masterGain.begin(frames);
+        }
+
+        void advanceRamps(int frames)
+        {
+            param1.advance(frames);
+            param2.advance(frames);
+            param3.advance(frames);
+            wavefoldAmount.advance(frames);
+            masterGain.advance(frames);
+        }
+
+        void finishRamps()
+        {
+            param1.finish();
+            param2.finish();
+            param3.finish();
+            wavefoldAmount.finish();
+            masterGain.finish();
+        }
+
+        static constexpr int kMaxControlBlocks = kMaxBlockSize / kControlBlockSize;
+
+        float sampleRate;
+
+        // Per voice, one array per field
+        OscillatorModule kernelOscillator; // the lane kernel algorithm all voices share
+        OscillatorModule::VoiceLanes<Voices> voiceLanes; // its per-voice phase and slew
+        std::array<OscillatorModule, Voices> oscillators; // for algorithms without a lane kernel
+        std::array<float, Voices> frequency;
+        std::array<float, Voices> velocity;
+        std::array<float, Voices> level; // envelope
+        std::array<bool, Voices> gate;
+        std::array<bool, Voices> active;
+        std::array<int, Voices> note;
+        std::array<uint32_t, Voices> started; // note-on order, for stealing the oldest
+        uint32_t noteCounter = 0;
+
+        // Shared
+        AlgorithmType algorithmType = AlgorithmType::TANH_SQUARE;
+        ParameterRamp param1{0.55f}; // Default drive for tanh square
+        ParameterRamp param2{0.5f};  // Default trim for tanh square
+        ParameterRamp param3{0.5f};
+        ParameterRamp wavefoldAmount{0.0f};
+        ParameterRamp masterGain{0.8f};
+        EnvelopeModule envelopeSettings; // holds the attack and release times; levels are per voice
+        WavefolderModule wavefolder;
+        ReverbModule reverb;
+        bool isPlaying = false;
+
+        float controlParam1[kMaxControlBlocks];
+        float controlParam2[kMaxControlBlocks];
+        float controlParam3[kMaxControlBlocks];
+        // Interleaved by voice
+        float voiceLeft[kMaxBlockSize * Voices];
+        float voiceRight[kMaxBlockSize * Voices];
+        float foldAmountBuffer[kMaxBlockSize * Voices];
+        float envelopeBuffer[kMaxBlockSize * Voices];
+
+        float scratchLeft[kMaxBlockSize];
+        float scratchRight[kMaxBlockSize];
+        float masterBuffer[kMaxBlockSize];
+        float envelopeSum[kMaxBlockSize];
+    };
+
+} // namespace flues::disyn
@@ -0,0 +1,51 @@
+#pragma once
+
+// Generated by tools/analyze_gains.cpp --header; do not edit by hand. Measured at 44100 Hz,
+// pitches 55,220,880 Hz, 9 points per param, 4096 samples per point,
+// target peak 1.2 into the wavefolder and RMS 0.4 after it.
+
+#include <array>
+
+#include "AlgorithmTypes.hpp"
+
+namespace flues::disyn {
+
+struct AlgorithmGains {
+    float fold;
+    float output;
+};
+
+inline constexpr std::array<AlgorithmGains, kAlgorithmTypeCount> kMeasuredAlgorithmGains = {{
+    {3.0000f, 0.9316f}, // Dirichlet
+    {3.1176f, 4.8946f}, // DSF Single
+    {3.1149f, 46.7025f}, // DSF Double
+    {2.0000f, 5.8920f}, // Tanh Square
+    {2.0000f, 3.1538f}, // Tanh Saw
+    {2.5210f, 129.5777f}, // PAF
+    {2.5196f, 114.6372f}, // Mod FM
+    {2.5616f, 32.6315f}, // Formant
+    {1.4617f, 35.4211f}, // Cascade
+    {2.7183f, 204.0724f}, // Banks
+    {2.1330f, 7.1579f}, // Feedback
+    {3.0850f, 146.0596f}, // Morphing
+    {3.0000f, 1.0859f}, // Inharmonic
+    {1.6094f, 1434.2890f}, // AFilter
+    {1.2000f, 146.7905f}, // Multi
+    {2.0708f, 1343.2216f}, // Asym
+    {1.0000f, 37.0228f}, // Cross
+    {2.0000f, 0.6108f}, // Taylor
+    {2.4000f, 0.8054f}, // Trajectory
+    {1.2000f, 0.5548f}, // Sine
+    {1.2000f, 0.6726f}, // Ramp
+    {1.2000f, 0.6762f}, // Triangle
+    {1.2000f, 0.4000f}, // Pulse
+    {1.2244f, 0.6150f}, // Noise
+    {1.2638f, 0.6433f}, // Logistic
+    {1.3587f, 0.8619f}, // Butterfly
+}};
+
+constexpr const AlgorithmGains& measuredGains(AlgorithmType type) {
+    return kMeasuredAlgorithmGains[static_cast<std::size_t>(type)];
+}
+
+} // namespace flues::disyn
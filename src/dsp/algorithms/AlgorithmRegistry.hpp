@@ -0,0 +1,226 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "AlgorithmGains.hpp"
+#include "AlgorithmTypes.hpp"
+
+namespace flues::disyn {
+
+struct AlgorithmParamInfo {
+    const char* label;
+    float minValue;
+    float maxValue;
+    bool integer;
+};
+
+// What the UI shows for an algorithm: display name and the ranges of its two main params.
+struct AlgorithmInfo {
+    const char* name;
+    AlgorithmParamInfo param1;
+    AlgorithmParamInfo param2;
+};
+
+// Safety limits on the gains the engine applies, after the voicing trim: the fold gain never
+// boosts into the wavefolder and the output gain never lifts a quiet algorithm by more than 6 dB.
+inline constexpr float kMaxFoldGain = 1.0f;
+inline constexpr float kMaxOutputGain = 2.0f;
+
+struct AlgorithmDescriptor {
+    AlgorithmType type;
+    AlgorithmInfo info;
+    AlgorithmGains voicing;  // listening-pass trim on the measured gains; 1 = as measured
+    bool active;             // part of the default build profile
+
+    // Applied before the wavefolder.
+    constexpr float foldGain() const {
+        return std::min(kMaxFoldGain, measuredGains(type).fold * voicing.fold);
+    }
+
+    // Applied with the envelope.
+    constexpr float outputGain() const {
+        return std::min(kMaxOutputGain, measuredGains(type).output * voicing.output);
+    }
+};
+
+// Single table of per-algorithm metadata, indexed by AlgorithmType. The measured gains are
+// generated into AlgorithmGains.hpp by tools/analyze_gains.cpp, which measures output gain
+// after the applied fold gain; voicing holds what the listening passes changed on top, so a
+// trim far from 1 (the low fold trims keep those algorithms out of heavy folding) is a choice
+// by ear rather than a correction to the measurement. The active set is from the latest
+// listening pass.
+inline constexpr std::array<AlgorithmDescriptor, kAlgorithmTypeCount> kAlgorithmRegistry = {{
+    {AlgorithmType::DIRICHLET_PULSE,
+     {"Dirichlet", {"Harm", 1.0f, 64.0f, true}, {"Tilt", -3.0f, 15.0f, false}},
+     {0.3004f, 0.5068f}, true},
+    {AlgorithmType::DSF_SINGLE,
+     {"DSF Single", {"Dec", 0.0f, 0.98f, false}, {"Rat", 0.5f, 4.0f, false}},
+     {0.07859f, 0.2043f}, false},
+    {AlgorithmType::DSF_DOUBLE,
+     {"DSF Double", {"Dec", 0.0f, 0.96f, false}, {"Rat", 0.5f, 4.5f, false}},
+     {0.01117f, 0.02141f}, false},
+    {AlgorithmType::TANH_SQUARE,
+     {"Tanh Square", {"Drv", 0.05f, 5.0f, false}, {"Trim", 0.2f, 1.2f, false}},
+     {0.05f, 0.03394f}, false},
+    {AlgorithmType::TANH_SAW,
+     {"Tanh Saw", {"Drv", 0.05f, 4.5f, false}, {"Blend", 0.0f, 1.0f, false}},
+     {0.1f, 0.1583f}, false},
+    {AlgorithmType::PAF,
+     {"PAF", {"Form", 0.5f, 6.0f, false}, {"BW", 50.0f, 3000.0f, false}},
+     {0.003967f, 0.006174f}, false},
+    {AlgorithmType::MOD_FM,
+     {"Mod FM", {"Idx", 0.01f, 8.0f, false}, {"Rat", 0.25f, 6.0f, false}},
+     {0.003969f, 0.005234f}, false},
+    {AlgorithmType::COMBINATION_1_HYBRID_FORMANT,
+     {"Formant", {"Idx", 0.01f, 3.0f, false}, {"Space", 0.0f, 1.0f, false}},
+     {0.01952f, 0.03065f}, true},
+    {AlgorithmType::COMBINATION_2_CASCADED,
+     {"Cascade", {"DSF Dec", 0.5f, 0.95f, false}, {"Asym", 0.5f, 2.0f, false}},
+     {0.006841f, 0.01129f}, false},
+    {AlgorithmType::COMBINATION_3_PARALLEL_BANK,
+     {"Banks", {"Idx", 0.01f, 8.0f, false}, {"Mix", 0.0f, 1.0f, false}},
+     {0.003679f, 0.00294f}, false},
+    {AlgorithmType::COMBINATION_4_FEEDBACK,
+     {"Feedback", {"Idx", 0.01f, 8.0f, false}, {"Fb", 0.0f, 0.95f, false}},
+     {0.04688f, 0.1147f}, false},
+    {AlgorithmType::COMBINATION_5_MORPHING,
+     {"Morphing", {"Morph", 0.0f, 1.0f, false}, {"Char", 0.0f, 1.0f, false}},
+     {0.003241f, 0.003423f}, false},
+    {AlgorithmType::COMBINATION_6_INHARMONIC,
+     {"Inharmonic", {"DSF Dec", 0.5f, 0.9f, false}, {"PAF Sh", 5.0f, 50.0f, false}},
+     {1.0f, 0.7337f}, false},
+    {AlgorithmType::COMBINATION_7_ADAPTIVE_FILTER,
+     {"AFilter", {"Cut", 0.0f, 1.0f, false}, {"Res", 0.0f, 1.0f, false}},
+     {0.0002485f, 0.0003486f}, false},
+    {AlgorithmType::NOVEL_1_MULTISTAGE,
+     {"Multi", {"Tanh", 0.1f, 10.0f, false}, {"Exp", 0.1f, 1.5f, false}},
+     {0.002958f, 0.002725f}, false},
+    {AlgorithmType::NOVEL_2_FREQ_ASYMMETRY,
+     {"Asym", {"LowR", 0.5f, 1.0f, false}, {"HiR", 1.0f, 2.0f, false}},
+     {0.0003376f, 0.0003722f}, false},
+    {AlgorithmType::NOVEL_3_CROSS_MOD,
+     {"Cross", {"M1", 0.0f, 1.0f, false}, {"M2", 0.0f, 1.0f, false}},
+     {0.01f, 0.02679f}, false},
+    {AlgorithmType::NOVEL_4_TAYLOR,
+     {"Taylor", {"T1", 1.0f, 10.0f, true}, {"T2", 1.0f, 10.0f, true}},
+     {1.0f, 0.7369f}, true},
+    {AlgorithmType::TRAJECTORY,
+     {"Trajectory", {"Sides", 3.0f, 12.0f, true}, {"Ang", 0.0f, 360.0f, false}},
+     {1.0f, 0.855f}, true},
+    {AlgorithmType::SINE,
+     {"Sine", {"Quant", 1.0f, 64.0f, true}, {"P2", 0.0f, 1.0f, false}},
+     {1.0f, 1.442f}, true},
+    {AlgorithmType::RAMP,
+     {"Ramp", {"Quant", 1.0f, 64.0f, true}, {"P2", 0.0f, 1.0f, false}},
+     {1.0f, 1.189f}, true},
+    {AlgorithmType::TRIANGLE,
+     {"Triangle", {"Quant", 1.0f, 64.0f, true}, {"P2", 0.0f, 1.0f, false}},
+     {1.0f, 1.183f}, true},
+    {AlgorithmType::PULSE,
+     {"Pulse", {"Width", 0.05f, 0.95f, false}, {"P2", 0.0f, 1.0f, false}},
+     {1.0f, 2.0f}, true},
+    {AlgorithmType::NOISE,
+     {"Noise", {"Smooth", 0.0f, 1.0f, false}, {"P2", 0.0f, 1.0f, false}},
+     {1.0f, 1.0f}, true},
+    {AlgorithmType::LOGISTIC,
+     {"Logistic", {"Smooth", 0.0f, 1.0f, false}, {"P2", 0.0f, 1.0f, false}},
+     {1.0f, 0.9327f}, true},
+    {AlgorithmType::BUTTERFLY,
+     {"Butterfly", {"Smooth", 0.0f, 1.0f, false}, {"P2", 0.0f, 1.0f, false}},
+     {1.0f, 0.6961f}, true},
+}};
+
+namespace detail {
+
+constexpr bool registryMatchesEnum() {
+    for (std::size_t i = 0; i < kAlgorithmRegistry.size(); ++i) {
+        if (static_cast<std::size_t>(kAlgorithmRegistry[i].type) != i) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace detail
+
+static_assert(detail::registryMatchesEnum(), "kAlgorithmRegistry must be listed in AlgorithmType order");
+
+constexpr bool isValidAlgorithm(int type) {
+    return type >= 0 && static_cast<std::size_t>(type) < kAlgorithmTypeCount;
+}
+
+constexpr const AlgorithmDescriptor& algorithmDescriptor(AlgorithmType type) {
+    return kAlgorithmRegistry[static_cast<std::size_t>(type)];
+}
+
+// Build profile: bit N set compiles in the algorithm with AlgorithmType value N. Leave
+// DISYN_ALGOS undefined for the algorithms marked active above, set it to DISYN_ALGOS_ALL for
+// every algorithm, or pass a mask such as -DDISYN_ALGOS="(1u << 19) | (1u << 20)". Algorithms
+// outside the profile render silence, are left out of the menu and are never instantiated.
+#define DISYN_ALGOS_ALL 0xFFFFFFFFu
+
+static_assert(kAlgorithmTypeCount <= 32, "DISYN_ALGOS holds one bit per algorithm");
+
+namespace detail {
+
+constexpr uint32_t kAllAlgorithmsMask =
+    kAlgorithmTypeCount == 32 ? 0xFFFFFFFFu : (1u << kAlgorithmTypeCount) - 1u;
+
+constexpr uint32_t defaultProfileMask() {
+    uint32_t mask = 0;
+    for (std::size_t i = 0; i < kAlgorithmRegistry.size(); ++i) {
+        if (kAlgorithmRegistry[i].active) {
+            mask |= 1u << i;
+        }
+    }
+    return mask;
+}
+
+} // namespace detail
+
+#ifdef DISYN_ALGOS
+inline constexpr uint32_t kAlgorithmProfile = static_cast<uint32_t>(DISYN_ALGOS) & detail::kAllAlgorithmsMask;
+#else
+inline constexpr uint32_t kAlgorithmProfile = detail::defaultProfileMask();
+#endif
+
+static_assert(kAlgorithmProfile != 0, "DISYN_ALGOS selects no algorithms");
+
+constexpr bool isAlgorithmActive(AlgorithmType type) {
+    return (kAlgorithmProfile >> static_cast<std::size_t>(type)) & 1u;
+}
+
+namespace detail {
+
+constexpr std::size_t countActiveAlgorithms() {
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < kAlgorithmTypeCount; ++i) {
+        count += isAlgorithmActive(static_cast<AlgorithmType>(i)) ? 1 : 0;
+    }
+    return count;
+}
+
+template <std::size_t Count>
+constexpr std::array<AlgorithmType, Count> listActiveAlgorithms() {
+    std::array<AlgorithmType, Count> list{};
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < kAlgorithmTypeCount; ++i) {
+        if (isAlgorithmActive(static_cast<AlgorithmType>(i))) {
+            list[count++] = static_cast<AlgorithmType>(i);
+        }
+    }
+    return list;
+}
+
+} // namespace detail
+
+inline constexpr std::size_t kActiveAlgorithmCount = detail::countActiveAlgorithms();
+
+// Algorithms in this build, in AlgorithmType order; the UI menu and tools iterate this.
+inline constexpr std::array<AlgorithmType, kActiveAlgorithmCount> kActiveAlgorithms =
+    detail::listActiveAlgorithms<kActiveAlgorithmCount>();
+
+} // namespace flues::disyn
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstddef>
+
 namespace flues::disyn {
 
 enum class AlgorithmType : int {
@@ -38,4 +40,6 @@ enum class AlgorithmType : int {
     BUTTERFLY = 25
 };
 
+constexpr std::size_t kAlgorithmTypeCount = static_cast<std::size_t>(AlgorithmType::BUTTERFLY) + 1;
+
 } // namespace flues::disyn
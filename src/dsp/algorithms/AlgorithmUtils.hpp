@@ -1,7 +1,10 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
 #include <cmath>
+#include <cstddef>
+#include <cstdint>
 
 #include "AlgorithmOutput.hpp"
 
@@ -9,6 +12,25 @@
 #undef TWO_PI
 #endif
 
+#ifndef DISYN_ALGORITHM_SLEW
+#define DISYN_ALGORITHM_SLEW 1
+#endif
+
+// Math kernels: DISYN_MATH_FAST (default) uses the sine table and the Pade tanh below;
+// DISYN_MATH_REFERENCE swaps them for libm in double precision. The reference build is the
+// accuracy baseline (tools/math_check.cpp compares the two) and the exact path for hosts with
+// time to spare.
+#define DISYN_MATH_REFERENCE 0
+#define DISYN_MATH_FAST 1
+
+#ifndef DISYN_MATH
+#define DISYN_MATH DISYN_MATH_FAST
+#endif
+
+#if DISYN_MATH != DISYN_MATH_REFERENCE && DISYN_MATH != DISYN_MATH_FAST
+#error "DISYN_MATH must be DISYN_MATH_REFERENCE or DISYN_MATH_FAST"
+#endif
+
 namespace flues::disyn
 {
 
@@ -17,13 +39,211 @@ namespace flues::disyn
     constexpr float DSF_MIN_DENOM = 1e-2f;
     constexpr float ASYM_MAX_GAIN = 1.5f;
     constexpr float OUTPUT_LIMIT = 0.5f;
+    constexpr float INV_TWO_PI = 1.0f / TWO_PI;
+
+    // One cycle of sine, linearly interpolated. 1024 segments keep the interpolation error
+    // below (2*pi/1024)^2 / 8 = 4.7e-6 (about -106 dB); measured max abs error vs std::sin is 4.8e-6.
+    constexpr std::size_t SINE_TABLE_SIZE = 1024;
+
+    namespace detail
+    {
+        constexpr double constexprSin(double x)
+        {
+            // x is in [0, 2*pi]; fold into [-pi/2, pi/2] so the series converges quickly.
+            constexpr double pi = 3.14159265358979323846;
+            if (x > pi)
+            {
+                x -= 2.0 * pi;
+            }
+            if (x > pi * 0.5)
+            {
+                x = pi - x;
+            }
+            else if (x < -pi * 0.5)
+            {
+                x = -pi - x;
+            }
+            double term = x;
+            double sum = x;
+            for (int n = 1; n < 12; ++n)
+            {
+                term *= -x * x / static_cast<double>((2 * n) * (2 * n + 1));
+                sum += term;
+            }
+            return sum;
+        }
+
+        constexpr std::array<float, SINE_TABLE_SIZE + 1> makeSineTable()
+        {
+            std::array<float, SINE_TABLE_SIZE + 1> table{};
+            for (std::size_t i = 0; i <= SINE_TABLE_SIZE; ++i)
+            {
+                const double x = 2.0 * 3.14159265358979323846 * static_cast<double>(i)
+                    / static_cast<double>(SINE_TABLE_SIZE);
+                table[i] = static_cast<float>(constexprSin(x));
+            }
+            return table;
+        }
+    } // namespace detail
+
+    // Extra guard point at the end so interpolation never needs to wrap.
+    inline constexpr std::array<float, SINE_TABLE_SIZE + 1> SINE_TABLE = detail::makeSineTable();
+
+    // sin(2*pi*phase). Phase is in cycles; values outside [0, 1) wrap, so phase offsets and
+    // negative phases need no pre-wrapping. The table index is masked, so it never reads out of bounds.
+    inline float sinePhase(float phase)
+    {
+#if DISYN_MATH == DISYN_MATH_REFERENCE
+        return static_cast<float>(std::sin(2.0 * M_PI * static_cast<double>(phase)));
+#else
+        const float position = phase * static_cast<float>(SINE_TABLE_SIZE);
+        int index = static_cast<int>(position);
+        if (position < static_cast<float>(index))
+        {
+            --index;
+        }
+        const float fraction = position - static_cast<float>(index);
+        const std::size_t wrapped = static_cast<std::size_t>(index) & (SINE_TABLE_SIZE - 1);
+        const float a = SINE_TABLE[wrapped];
+        const float b = SINE_TABLE[wrapped + 1];
+        return a + (b - a) * fraction;
+#endif
+    }
 
-    inline float stepPhase(float currentPhase, float frequency, float sampleRate)
+    // cos(2*pi*phase), same accuracy as sinePhase.
+    inline float cosinePhase(float phase)
     {
-        const float next = currentPhase + frequency / sampleRate;
-        return next - std::floor(next);
+        return sinePhase(phase + 0.25f);
     }
 
+    constexpr float CYCLES_TO_PHASE = 4294967296.0f;
+    constexpr int SINE_TABLE_BITS = 10;
+    constexpr int SINE_FRACTION_BITS = 32 - SINE_TABLE_BITS;
+    constexpr float SINE_FRACTION_SCALE = 1.0f / static_cast<float>(1u << SINE_FRACTION_BITS);
+    static_assert((1u << SINE_TABLE_BITS) == SINE_TABLE_SIZE, "SINE_TABLE_BITS must match SINE_TABLE_SIZE");
+
+    // Converts a phase in cycles to 32-bit fixed point; values outside [0, 1) wrap.
+    inline uint32_t phaseFromCycles(float cycles)
+    {
+        return static_cast<uint32_t>(static_cast<int64_t>(cycles * CYCLES_TO_PHASE));
+    }
+
+    // The fixed-point phase in cycles, always in [0, 1).
+    inline float cyclesFromPhase(uint32_t phase)
+    {
+        return static_cast<float>(phase >> 8) * (1.0f / 16777216.0f);
+    }
+
+    // sin(2*pi*phase / 2^32). The top bits index the table directly and the rest interpolate.
+    inline float sineFromPhase(uint32_t phase)
+    {
+#if DISYN_MATH == DISYN_MATH_REFERENCE
+        return static_cast<float>(std::sin(2.0 * M_PI / 4294967296.0 * static_cast<double>(phase)));
+#else
+        const uint32_t index = phase >> SINE_FRACTION_BITS;
+        const float fraction = static_cast<float>(phase & ((1u << SINE_FRACTION_BITS) - 1u)) * SINE_FRACTION_SCALE;
+        const float a = SINE_TABLE[index];
+        const float b = SINE_TABLE[index + 1];
+        return a + (b - a) * fraction;
+#endif
+    }
+
+    inline float cosineFromPhase(uint32_t phase)
+    {
+        return sineFromPhase(phase + (1u << 30));
+    }
+
+    // 32-bit numerically controlled oscillator. The increment is computed once per block by
+    // setFrequency, so the inner loop is a single integer add that wraps for free; no divide or
+    // floor per sample, and no float precision loss at low pitches.
+    class PhaseAccumulator
+    {
+    public:
+        void reset()
+        {
+            phase = 0u;
+        }
+
+        void setFrequency(float frequency, float sampleRate)
+        {
+            increment = phaseFromCycles(frequency / sampleRate);
+        }
+
+        // Returns true when the phase wrapped past the end of the cycle.
+        bool advance()
+        {
+            phase += increment;
+            return phase < increment;
+        }
+
+        uint32_t raw() const
+        {
+            return phase;
+        }
+
+        void setRaw(uint32_t value)
+        {
+            phase = value;
+        }
+
+        // Phase in cycles, always in [0, 1).
+        float value() const
+        {
+            return cyclesFromPhase(phase);
+        }
+
+        float sine() const
+        {
+            return sineFromPhase(phase);
+        }
+
+        float cosine() const
+        {
+            return cosineFromPhase(phase);
+        }
+
+    private:
+        uint32_t phase = 0u;
+        uint32_t increment = 0u;
+    };
+
+    // What an algorithm with a lane kernel carries from sample to sample: its phase and the
+    // kernel's two slew states. OscillatorModule seeds unison lanes from it and hands it back.
+    struct LaneState
+    {
+        uint32_t phase = 0u;
+        float slewPrimary = 0.0f;
+        float slewSecondary = 0.0f;
+    };
+
+    // The control inputs an algorithm last prepared for. prepare() asks changed() first and
+    // skips the parameter mapping while the knobs and pitch are steady.
+    class ControlInputs
+    {
+    public:
+        bool changed(float pitch, float param1, float param2, float param3)
+        {
+            if (valid && pitch == lastPitch && param1 == lastParam1 && param2 == lastParam2
+                && param3 == lastParam3)
+            {
+                return false;
+            }
+            valid = true;
+            lastPitch = pitch;
+            lastParam1 = param1;
+            lastParam2 = param2;
+            lastParam3 = param3;
+            return true;
+        }
+
+    private:
+        bool valid = false;
+        float lastPitch = 0.0f;
+        float lastParam1 = 0.0f;
+        float lastParam2 = 0.0f;
+        float lastParam3 = 0.0f;
+    };
+
     inline float expoMap(float value, float min, float max)
     {
         const float clamped = std::clamp(value, 0.0f, 1.0f);
@@ -40,14 +260,39 @@ namespace flues::disyn
         return clampAbs(value, OUTPUT_LIMIT);
     }
 
+    // Clamped [7/6] Pade approximant of tanh: one divide and two clamps, no libm call.
+    // Max abs error vs std::tanh over [-8, 8] is 9.6e-5, RMS 2.5e-5 (see tools/tanh_error.cpp).
+    constexpr float FAST_TANH_CLAMP = 4.97f;
+    constexpr float FAST_TANH_MAX_ERROR = 1e-4f;
+
+    inline float fastTanh(float x)
+    {
+#if DISYN_MATH == DISYN_MATH_REFERENCE
+        return static_cast<float>(std::tanh(static_cast<double>(x)));
+#else
+        x = std::clamp(x, -FAST_TANH_CLAMP, FAST_TANH_CLAMP);
+        const float x2 = x * x;
+        const float numerator = x * (135135.0f + x2 * (17325.0f + x2 * (378.0f + x2)));
+        const float denominator = 135135.0f + x2 * (62370.0f + x2 * (3150.0f + x2 * 28.0f));
+        return std::clamp(numerator / denominator, -1.0f, 1.0f);
+#endif
+    }
+
+    // Exact saturation; use where the curve itself is the sound and accuracy matters.
     inline float softClip(float value)
     {
         return std::tanh(value);
     }
 
+    // Approximate saturation for output guards and shaping stages.
+    inline float softClipFast(float value)
+    {
+        return fastTanh(value);
+    }
+
     inline float softClipBlend(float value, float amount)
     {
-        const float clipped = softClip(value);
+        const float clipped = softClipFast(value);
         return value + (clipped - value) * std::clamp(amount, 0.0f, 1.0f);
     }
 
@@ -57,10 +302,19 @@ namespace flues::disyn
         return state;
     }
 
+    // Parameter changes are ramped by DisynEngine, so the output slew is no longer needed to hide
+    // block steps; it stays on by default because its low-pass is part of the tuned sound.
+    // Build with -DDISYN_ALGORITHM_SLEW=0 to drop it and keep only the soft clip.
     inline float shapeAndSlew(float value, float &state, float slewCoeff, float clipAmount)
     {
         const float shaped = softClipBlend(value, clipAmount);
+#if DISYN_ALGORITHM_SLEW
         return slewLimit(shaped, state, slewCoeff);
+#else
+        (void)slewCoeff;
+        state = shaped;
+        return shaped;
+#endif
     }
 
     inline float stableModGain(float index, float modulator)
@@ -81,29 +335,39 @@ namespace flues::disyn
         return {primary, secondary};
     }
 
+    // Branch-free (limit is positive, so maxAbs > limit also rules out a zero divide), which
+    // lets the unison lanes that end in it vectorise. Scaling by 1 leaves the value unchanged.
     inline AlgorithmOutput normalizeOutputLimit(float primary, float secondary, float limit)
     {
         const float maxAbs = std::max(std::abs(primary), std::abs(secondary));
-        if (maxAbs > limit && maxAbs > 0.0f)
-        {
-            const float scale = limit / maxAbs;
-            primary *= scale;
-            secondary *= scale;
-        }
-        return {primary, secondary};
+        const float scale = maxAbs > limit ? limit / maxAbs : 1.0f;
+        return {primary * scale, secondary * scale};
     }
 
-    inline float quantizeBipolar(float value, int steps)
+    // Bipolar step quantizer with the step size resolved at control rate.
+    class BipolarQuantizer
     {
-        if (steps <= 1)
+    public:
+        void setSteps(int steps)
         {
-            return value;
+            levels = steps > 1 ? static_cast<float>(steps - 1) : 0.0f;
+            invLevels = steps > 1 ? 1.0f / levels : 0.0f;
         }
-        const float scaled = (value + 1.0f) * 0.5f;
-        const float quantized = std::round(scaled * static_cast<float>(steps - 1))
-            / static_cast<float>(steps - 1);
-        return quantized * 2.0f - 1.0f;
-    }
+
+        float apply(float value) const
+        {
+            if (levels <= 0.0f)
+            {
+                return value;
+            }
+            const float scaled = (value + 1.0f) * 0.5f;
+            return std::round(scaled * levels) * invLevels * 2.0f - 1.0f;
+        }
+
+    private:
+        float levels = 0.0f;
+        float invLevels = 0.0f;
+    };
 
     inline float safeExp(float x)
     {
@@ -118,37 +382,41 @@ namespace flues::disyn
         return std::exp(x);
     }
 
+    // w and t are phases in cycles rather than radians.
     inline float computeDSFComponent(float w, float t, float decay)
     {
-        float denominator = 1.0f - 2.0f * decay * std::cos(t) + decay * decay;
+        float denominator = 1.0f - 2.0f * decay * cosinePhase(t) + decay * decay;
         if (denominator < DSF_MIN_DENOM)
         {
             denominator = DSF_MIN_DENOM;
         }
 
-        const float numerator = std::sin(w) - decay * std::sin(w - t);
+        const float numerator = sinePhase(w) - decay * sinePhase(w - t);
         const float normalise = std::sqrt(1.0f - decay * decay);
         return (numerator / denominator) * normalise;
     }
 
     inline float processAsymmetricFM(float param1, float param2, float frequency,
-                                     float sampleRate, float &carrierPhaseRef, float &modPhaseRef)
+                                     float sampleRate, PhaseAccumulator &carrierPhaseRef,
+                                     PhaseAccumulator &modPhaseRef)
     {
         const float k = expoMap(param1, 0.01f, 3.0f);
         const float r = expoMap(param2, 0.8f, 1.2f);
         const float modFreq = frequency;
 
-        carrierPhaseRef = stepPhase(carrierPhaseRef, frequency, sampleRate);
-        modPhaseRef = stepPhase(modPhaseRef, modFreq, sampleRate);
+        carrierPhaseRef.setFrequency(frequency, sampleRate);
+        modPhaseRef.setFrequency(modFreq, sampleRate);
+        carrierPhaseRef.advance();
+        modPhaseRef.advance();
 
-        const float modulator = std::sin(TWO_PI * modPhaseRef);
-        const float drive = k * (r - 1.0f / r) * std::cos(TWO_PI * modPhaseRef) * 0.5f;
-        float asymmetry = 1.0f + 0.5f * std::tanh(drive);
+        const float modulator = modPhaseRef.sine();
+        const float drive = k * (r - 1.0f / r) * modPhaseRef.cosine() * 0.5f;
+        float asymmetry = 1.0f + 0.5f * fastTanh(drive);
         if (asymmetry > ASYM_MAX_GAIN)
         {
             asymmetry = ASYM_MAX_GAIN;
         }
-        const float carrier = std::cos(TWO_PI * carrierPhaseRef + k * modulator);
+        const float carrier = cosinePhase(carrierPhaseRef.value() + k * modulator * INV_TWO_PI);
 
         return carrier * asymmetry * 0.4f;
     }
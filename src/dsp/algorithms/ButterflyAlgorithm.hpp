@@ -24,33 +24,53 @@ public:
     }
 
     AlgorithmOutput process(float pitch, float param1, float param2, float param3) {
-        (void)param2;
-        (void)param3;
+        prepare(pitch, param1, param2, param3);
+        AlgorithmOutput output{};
+        processBlock(&output.primary, &output.secondary, 1);
+        return output;
+    }
+
+    void prepare(float pitch, float param1, float param2, float param3) {
+        if (!inputs.changed(pitch, param1, param2, param3)) {
+            return;
+        }
+
         const float smoothing = std::clamp(param1, 0.0f, 1.0f);
-        const float slewCoeff = 0.01f + (1.0f - smoothing) * 0.19f;
-        const float dt = std::clamp(pitch / sampleRate, 0.0001f, 0.05f);
+        coeffs.slewCoeff = 0.01f + (1.0f - smoothing) * 0.19f;
+        coeffs.dt = std::clamp(pitch / sampleRate, 0.0001f, 0.05f);
+    }
 
+    void processBlock(float* primary, float* secondary, int frames) {
+        const Coefficients c = coeffs;
         const float sigma = 10.0f;
         const float rho = 28.0f;
         const float beta = 2.6666667f;
 
-        const float dx = sigma * (y - x);
-        const float dy = x * (rho - z) - y;
-        const float dz = x * y - beta * z;
+        for (int i = 0; i < frames; ++i) {
+            const float dx = sigma * (y - x);
+            const float dy = x * (rho - z) - y;
+            const float dz = x * y - beta * z;
 
-        x += dx * dt;
-        y += dy * dt;
-        z += dz * dt;
+            x += dx * c.dt;
+            y += dy * c.dt;
+            z += dz * c.dt;
 
-        const float rawPrimary = softClip(x * 0.05f);
-        const float rawSecondary = softClip(y * 0.05f);
-        const float smoothedPrimary = slewLimit(rawPrimary, outPrimary, slewCoeff);
-        const float smoothedSecondary = slewLimit(rawSecondary, outSecondary, slewCoeff);
-        return {smoothedPrimary, smoothedSecondary};
+            const float rawPrimary = softClipFast(x * 0.05f);
+            const float rawSecondary = softClipFast(y * 0.05f);
+            primary[i] = slewLimit(rawPrimary, outPrimary, c.slewCoeff);
+            secondary[i] = slewLimit(rawSecondary, outSecondary, c.slewCoeff);
+        }
     }
 
 private:
+    struct Coefficients {
+        float slewCoeff;
+        float dt;
+    };
+
     float sampleRate;
+    ControlInputs inputs;
+    Coefficients coeffs{};
     float x;
     float y;
     float z;
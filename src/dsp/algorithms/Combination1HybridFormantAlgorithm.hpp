@@ -9,58 +9,82 @@ class Combination1HybridFormantAlgorithm {
 public:
     explicit Combination1HybridFormantAlgorithm(float sampleRate)
         : sampleRate(sampleRate),
-          phase(0.0f),
-          modPhase(0.0f),
-          formant1Phase(0.0f),
-          formant2Phase(0.0f),
-          formant3Phase(0.0f),
+          phase(),
+          modPhase(),
+          formant1Phase(),
+          formant2Phase(),
+          formant3Phase(),
           outPrimary(0.0f),
           outSecondary(0.0f) {}
 
     void reset() {
-        phase = 0.0f;
-        modPhase = 0.0f;
-        formant1Phase = 0.0f;
-        formant2Phase = 0.0f;
-        formant3Phase = 0.0f;
+        phase.reset();
+        modPhase.reset();
+        formant1Phase.reset();
+        formant2Phase.reset();
+        formant3Phase.reset();
         outPrimary = 0.0f;
         outSecondary = 0.0f;
     }
 
     AlgorithmOutput process(float pitch, float param1, float param2, float param3) {
-        (void)param2;
+        prepare(pitch, param1, param2, param3);
+        AlgorithmOutput output{};
+        processBlock(&output.primary, &output.secondary, 1);
+        return output;
+    }
+
+    void prepare(float pitch, float param1, float param2, float param3) {
+        if (!inputs.changed(pitch, param1, param2, param3)) {
+            return;
+        }
+
         const float formantSpacing = 0.9f + param3 * 0.2f;
+        phase.setFrequency(pitch, sampleRate);
+        modPhase.setFrequency(pitch, sampleRate);
+        formant1Phase.setFrequency(800.0f * formantSpacing, sampleRate);
+        formant2Phase.setFrequency(1200.0f * formantSpacing, sampleRate);
+        formant3Phase.setFrequency(2400.0f * formantSpacing, sampleRate);
+    }
 
-        phase = stepPhase(phase, pitch, sampleRate);
-        modPhase = stepPhase(modPhase, pitch, sampleRate);
-        const float carrier = std::sin(TWO_PI * phase);
-        const float base = carrier * 0.4f;
+    void processBlock(float* primary, float* secondary, int frames) {
+        for (int i = 0; i < frames; ++i) {
+            phase.advance();
+            modPhase.advance();
+            const float carrier = phase.sine();
+            const float base = carrier * 0.4f;
 
-        formant1Phase = stepPhase(formant1Phase, 800.0f * formantSpacing, sampleRate);
-        formant2Phase = stepPhase(formant2Phase, 1200.0f * formantSpacing, sampleRate);
-        formant3Phase = stepPhase(formant3Phase, 2400.0f * formantSpacing, sampleRate);
+            formant1Phase.advance();
+            formant2Phase.advance();
+            formant3Phase.advance();
 
-        const float formant1 = std::sin(TWO_PI * formant1Phase) * 0.5f;
-        const float formant2 = std::sin(TWO_PI * formant2Phase) * 0.5f;
-        const float formant3 = std::sin(TWO_PI * formant3Phase) * 0.5f;
+            const float formant1 = formant1Phase.sine() * 0.5f;
+            const float formant2 = formant2Phase.sine() * 0.5f;
+            const float formant3 = formant3Phase.sine() * 0.5f;
 
-        // Prev tune: rawPrimary *0.4, rawSecondary *0.6, clipAmount 0.6, slewCoeff 0.05, limit 0.6.
-        const float rawPrimary = (base + formant1 + formant2 + formant3) * 0.6f;
-        const float rawSecondary = base * 0.6f;
-        const float clipAmount = 0.5f;
-        const float slewCoeff = 0.05f;
-        const float smoothedPrimary = shapeAndSlew(rawPrimary, outPrimary, slewCoeff, clipAmount);
-        const float smoothedSecondary = shapeAndSlew(rawSecondary, outSecondary, slewCoeff, clipAmount);
-        return normalizeOutputLimit(smoothedPrimary, smoothedSecondary, 0.8f);
+            // Prev tune: rawPrimary *0.4, rawSecondary *0.6, clipAmount 0.6, slewCoeff 0.05, limit 0.6.
+            const float rawPrimary = (base + formant1 + formant2 + formant3) * 0.6f;
+            const float rawSecondary = base * 0.6f;
+            const float smoothedPrimary = shapeAndSlew(rawPrimary, outPrimary, kSlewCoeff, kClipAmount);
+            const float smoothedSecondary = shapeAndSlew(rawSecondary, outSecondary, kSlewCoeff, kClipAmount);
+            const AlgorithmOutput result = normalizeOutputLimit(smoothedPrimary, smoothedSecondary, kOutputLimit);
+            primary[i] = result.primary;
+            secondary[i] = result.secondary;
+        }
     }
 
 private:
+    static constexpr float kClipAmount = 0.5f;
+    static constexpr float kSlewCoeff = 0.05f;
+    static constexpr float kOutputLimit = 0.8f;
+
     float sampleRate;
-    float phase;
-    float modPhase;
-    float formant1Phase;
-    float formant2Phase;
-    float formant3Phase;
+    ControlInputs inputs;
+    PhaseAccumulator phase;
+    PhaseAccumulator modPhase;
+    PhaseAccumulator formant1Phase;
+    PhaseAccumulator formant2Phase;
+    PhaseAccumulator formant3Phase;
     float outPrimary;
     float outSecondary;
 };
@@ -9,44 +9,90 @@ class Combination2CascadedAlgorithm {
 public:
     explicit Combination2CascadedAlgorithm(float sampleRate)
         : sampleRate(sampleRate),
-          phase(0.0f),
-          cascade1Phase(0.0f),
-          cascade2Phase(0.0f),
+          phase(),
+          cascade1Phase(),
+          cascade2Phase(),
           outPrimary(0.0f),
           outSecondary(0.0f) {}
 
     void reset() {
-        phase = 0.0f;
-        cascade1Phase = 0.0f;
-        cascade2Phase = 0.0f;
+        phase.reset();
+        cascade1Phase.reset();
+        cascade2Phase.reset();
         outPrimary = 0.0f;
         outSecondary = 0.0f;
     }
 
     AlgorithmOutput process(float pitch, float param1, float param2, float param3) {
-        (void)param2;
+        prepare(pitch, param1, param2, param3);
+        AlgorithmOutput output{};
+        processBlock(&output.primary, &output.secondary, 1);
+        return output;
+    }
+
+    void prepare(float pitch, float param1, float param2, float param3) {
+        if (!inputs.changed(pitch, param1, param2, param3)) {
+            return;
+        }
+
         // Prev tune: simple tanh blend, raw *0.8, clipAmount 0.5, slewCoeff 0.06, limit 0.8.
-        const float drive = 0.8f + std::clamp(param1, 0.0f, 1.0f) * 2.0f;
-        const float mix = std::clamp(param3, 0.0f, 1.0f);
+        coeffs.drive = 0.8f + std::clamp(param1, 0.0f, 1.0f) * 2.0f;
+        coeffs.mix = std::clamp(param3, 0.0f, 1.0f);
+        phase.setFrequency(pitch, sampleRate);
+    }
+
+    void processBlock(float* primary, float* secondary, int frames) {
+        const Coefficients c = coeffs;
+        for (int i = 0; i < frames; ++i) {
+            phase.advance();
+            const AlgorithmOutput result = kernel(c, phase.raw(), outPrimary, outSecondary);
+            primary[i] = result.primary;
+            secondary[i] = result.secondary;
+        }
+    }
+
+    struct Coefficients {
+        float drive;
+        float mix;
+    };
 
-        phase = stepPhase(phase, pitch, sampleRate);
-        const float carrier = std::sin(TWO_PI * phase);
-        const float shaped = std::tanh(carrier * drive);
+    const Coefficients& coefficients() const {
+        return coeffs;
+    }
+
+    static AlgorithmOutput kernel(const Coefficients& c, uint32_t phase, float& slewPrimary,
+                                  float& slewSecondary) {
+        const float carrier = sineFromPhase(phase);
+        const float shaped = fastTanh(carrier * c.drive);
 
-        const float rawPrimary = (carrier * (1.0f - mix) + shaped * mix) * 0.9f;
+        const float rawPrimary = (carrier * (1.0f - c.mix) + shaped * c.mix) * 0.9f;
         const float rawSecondary = shaped * 0.9f;
-        const float clipAmount = 0.4f;
-        const float slewCoeff = 0.06f;
-        const float smoothedPrimary = shapeAndSlew(rawPrimary, outPrimary, slewCoeff, clipAmount);
-        const float smoothedSecondary = shapeAndSlew(rawSecondary, outSecondary, slewCoeff, clipAmount);
-        return normalizeOutputLimit(smoothedPrimary, smoothedSecondary, 0.9f);
+        const float smoothedPrimary = shapeAndSlew(rawPrimary, slewPrimary, kSlewCoeff, kClipAmount);
+        const float smoothedSecondary = shapeAndSlew(rawSecondary, slewSecondary, kSlewCoeff, kClipAmount);
+        return normalizeOutputLimit(smoothedPrimary, smoothedSecondary, kOutputLimit);
+    }
+
+    LaneState laneState() const {
+        return {phase.raw(), outPrimary, outSecondary};
+    }
+
+    void setLaneState(const LaneState& state) {
+        phase.setRaw(state.phase);
+        outPrimary = state.slewPrimary;
+        outSecondary = state.slewSecondary;
     }
 
 private:
+    static constexpr float kClipAmount = 0.4f;
+    static constexpr float kSlewCoeff = 0.06f;
+    static constexpr float kOutputLimit = 0.9f;
+
     float sampleRate;
-    float phase;
-    float cascade1Phase;
-    float cascade2Phase;
+    ControlInputs inputs;
+    Coefficients coeffs{};
+    PhaseAccumulator phase;
+    PhaseAccumulator cascade1Phase;
+    PhaseAccumulator cascade2Phase;
     float outPrimary;
     float outSecondary;
 };
@@ -9,45 +9,71 @@ class Combination4FeedbackAlgorithm {
 public:
     explicit Combination4FeedbackAlgorithm(float sampleRate)
         : sampleRate(sampleRate),
-          phase(0.0f),
-          modPhase(0.0f),
+          phase(),
+          modPhase(),
           feedbackSample(0.0f),
           outPrimary(0.0f),
           outSecondary(0.0f) {}
 
     void reset() {
-        phase = 0.0f;
-        modPhase = 0.0f;
+        phase.reset();
+        modPhase.reset();
         feedbackSample = 0.0f;
         outPrimary = 0.0f;
         outSecondary = 0.0f;
     }
 
     AlgorithmOutput process(float pitch, float param1, float param2, float param3) {
-        (void)param2;
+        prepare(pitch, param1, param2, param3);
+        AlgorithmOutput output{};
+        processBlock(&output.primary, &output.secondary, 1);
+        return output;
+    }
+
+    void prepare(float pitch, float param1, float param2, float param3) {
+        if (!inputs.changed(pitch, param1, param2, param3)) {
+            return;
+        }
+
         // Prev tune: simplified tanh carrier, clipAmount 0.6, slewCoeff 0.05, limit 0.6.
-        const float drive = 0.6f + std::clamp(param1, 0.0f, 1.0f) * 2.0f;
-        const float modifiedFreq = pitch;
+        coeffs.drive = 0.6f + std::clamp(param1, 0.0f, 1.0f) * 2.0f;
+        phase.setFrequency(pitch, sampleRate);
+        modPhase.setFrequency(pitch, sampleRate);
+    }
 
-        phase = stepPhase(phase, modifiedFreq, sampleRate);
-        modPhase = stepPhase(modPhase, modifiedFreq, sampleRate);
-        const float carrier = std::cos(TWO_PI * phase);
-        feedbackSample = 0.0f;
+    void processBlock(float* primary, float* secondary, int frames) {
+        const Coefficients c = coeffs;
+        for (int i = 0; i < frames; ++i) {
+            phase.advance();
+            modPhase.advance();
+            const float carrier = phase.cosine();
+            feedbackSample = 0.0f;
 
-        const float shaped = std::tanh(carrier * drive);
-        const float rawPrimary = shaped * 0.6f;
-        const float rawSecondary = carrier * 0.4f;
-        const float clipAmount = 0.5f;
-        const float slewCoeff = 0.06f;
-        const float smoothedPrimary = shapeAndSlew(rawPrimary, outPrimary, slewCoeff, clipAmount);
-        const float smoothedSecondary = shapeAndSlew(rawSecondary, outSecondary, slewCoeff, clipAmount);
-        return normalizeOutputLimit(smoothedPrimary, smoothedSecondary, 0.8f);
+            const float shaped = fastTanh(carrier * c.drive);
+            const float rawPrimary = shaped * 0.6f;
+            const float rawSecondary = carrier * 0.4f;
+            const float smoothedPrimary = shapeAndSlew(rawPrimary, outPrimary, kSlewCoeff, kClipAmount);
+            const float smoothedSecondary = shapeAndSlew(rawSecondary, outSecondary, kSlewCoeff, kClipAmount);
+            const AlgorithmOutput result = normalizeOutputLimit(smoothedPrimary, smoothedSecondary, kOutputLimit);
+            primary[i] = result.primary;
+            secondary[i] = result.secondary;
+        }
     }
 
 private:
+    static constexpr float kClipAmount = 0.5f;
+    static constexpr float kSlewCoeff = 0.06f;
+    static constexpr float kOutputLimit = 0.8f;
+
+    struct Coefficients {
+        float drive;
+    };
+
     float sampleRate;
-    float phase;
-    float modPhase;
+    ControlInputs inputs;
+    Coefficients coeffs{};
+    PhaseAccumulator phase;
+    PhaseAccumulator modPhase;
     float feedbackSample;
     float outPrimary;
     float outSecondary;
@@ -9,71 +9,97 @@ class Combination5MorphingAlgorithm {
 public:
     explicit Combination5MorphingAlgorithm(float sampleRate)
         : sampleRate(sampleRate),
-          phase(0.0f),
-          modPhase(0.0f),
-          secondaryPhase(0.0f),
-          formant1Phase(0.0f),
+          phase(),
+          modPhase(),
+          secondaryPhase(),
+          formant1Phase(),
           outPrimary(0.0f),
           outSecondary(0.0f) {}
 
     void reset() {
-        phase = 0.0f;
-        modPhase = 0.0f;
-        secondaryPhase = 0.0f;
-        formant1Phase = 0.0f;
+        phase.reset();
+        modPhase.reset();
+        secondaryPhase.reset();
+        formant1Phase.reset();
         outPrimary = 0.0f;
         outSecondary = 0.0f;
     }
 
     AlgorithmOutput process(float pitch, float param1, float param2, float param3) {
-        const float morphCurve = 0.5f + std::clamp(param3, 0.0f, 1.0f) * 1.5f;
-        const float morphPos = std::pow(std::clamp(param1, 0.0f, 1.0f), morphCurve);
-        (void)param2;
-
-        float output = 0.0f;
-
-        float secondary = 0.0f;
-
-        if (morphPos < 0.5f) {
-            const float alpha = morphPos * 2.0f;
-
-            phase = stepPhase(phase, pitch, sampleRate);
-            const float sine = std::sin(TWO_PI * phase) * 0.5f;
-
-            modPhase = stepPhase(modPhase, pitch, sampleRate);
-            const float modfm = std::sin(TWO_PI * modPhase) * 0.5f;
-
-            output = sine * (1.0f - alpha) + modfm * alpha;
-            secondary = modfm;
-        } else {
-            const float alpha = (morphPos - 0.5f) * 2.0f;
+        prepare(pitch, param1, param2, param3);
+        AlgorithmOutput output{};
+        processBlock(&output.primary, &output.secondary, 1);
+        return output;
+    }
 
-            modPhase = stepPhase(modPhase, pitch, sampleRate);
-            const float modfm = std::sin(TWO_PI * modPhase) * 0.5f;
+    void prepare(float pitch, float param1, float param2, float param3) {
+        if (!inputs.changed(pitch, param1, param2, param3)) {
+            return;
+        }
 
-            formant1Phase = stepPhase(formant1Phase, pitch * 2.0f, sampleRate);
-            const float paf = std::sin(TWO_PI * formant1Phase) * 0.5f;
+        const float morphCurve = 0.5f + std::clamp(param3, 0.0f, 1.0f) * 1.5f;
+        const float morphPos = std::pow(std::clamp(param1, 0.0f, 1.0f), morphCurve);
+        coeffs.lowerHalf = morphPos < 0.5f;
+        coeffs.alpha = coeffs.lowerHalf ? morphPos * 2.0f : (morphPos - 0.5f) * 2.0f;
+        phase.setFrequency(pitch, sampleRate);
+        modPhase.setFrequency(pitch, sampleRate);
+        formant1Phase.setFrequency(pitch * 2.0f, sampleRate);
+    }
 
-            output = modfm * (1.0f - alpha) + paf * alpha;
-            secondary = paf;
+    void processBlock(float* primary, float* secondary, int frames) {
+        const Coefficients c = coeffs;
+        for (int i = 0; i < frames; ++i) {
+            float output = 0.0f;
+            float secondaryOut = 0.0f;
+
+            if (c.lowerHalf) {
+                phase.advance();
+                const float sine = phase.sine() * 0.5f;
+
+                modPhase.advance();
+                const float modfm = modPhase.sine() * 0.5f;
+
+                output = sine * (1.0f - c.alpha) + modfm * c.alpha;
+                secondaryOut = modfm;
+            } else {
+                modPhase.advance();
+                const float modfm = modPhase.sine() * 0.5f;
+
+                formant1Phase.advance();
+                const float paf = formant1Phase.sine() * 0.5f;
+
+                output = modfm * (1.0f - c.alpha) + paf * c.alpha;
+                secondaryOut = paf;
+            }
+
+            // Prev tune: raw *0.9, clipAmount 0.3, slewCoeff 0.06, limit 1.0.
+            const float rawPrimary = output * 0.8f;
+            const float rawSecondary = secondaryOut * 0.8f;
+            const float smoothedPrimary = shapeAndSlew(rawPrimary, outPrimary, kSlewCoeff, kClipAmount);
+            const float smoothedSecondary = shapeAndSlew(rawSecondary, outSecondary, kSlewCoeff, kClipAmount);
+            const AlgorithmOutput result = normalizeOutputLimit(smoothedPrimary, smoothedSecondary, kOutputLimit);
+            primary[i] = result.primary;
+            secondary[i] = result.secondary;
         }
-
-        // Prev tune: raw *0.9, clipAmount 0.3, slewCoeff 0.06, limit 1.0.
-        const float rawPrimary = output * 0.8f;
-        const float rawSecondary = secondary * 0.8f;
-        const float clipAmount = 0.4f;
-        const float slewCoeff = 0.06f;
-        const float smoothedPrimary = shapeAndSlew(rawPrimary, outPrimary, slewCoeff, clipAmount);
-        const float smoothedSecondary = shapeAndSlew(rawSecondary, outSecondary, slewCoeff, clipAmount);
-        return normalizeOutputLimit(smoothedPrimary, smoothedSecondary, 0.9f);
     }
 
 private:
+    static constexpr float kClipAmount = 0.4f;
+    static constexpr float kSlewCoeff = 0.06f;
+    static constexpr float kOutputLimit = 0.9f;
+
+    struct Coefficients {
+        bool lowerHalf;
+        float alpha;
+    };
+
     float sampleRate;
-    float phase;
-    float modPhase;
-    float secondaryPhase;
-    float formant1Phase;
+    ControlInputs inputs;
+    Coefficients coeffs{};
+    PhaseAccumulator phase;
+    PhaseAccumulator modPhase;
+    PhaseAccumulator secondaryPhase;
+    PhaseAccumulator formant1Phase;
     float outPrimary;
     float outSecondary;
 };
@@ -9,45 +9,70 @@ class Combination6InharmonicAlgorithm {
 public:
     explicit Combination6InharmonicAlgorithm(float sampleRate)
         : sampleRate(sampleRate),
-          phase(0.0f),
-          formant1Phase(0.0f),
+          phase(),
+          formant1Phase(),
           outPrimary(0.0f),
           outSecondary(0.0f) {}
 
     void reset() {
-        phase = 0.0f;
-        formant1Phase = 0.0f;
+        phase.reset();
+        formant1Phase.reset();
         outPrimary = 0.0f;
         outSecondary = 0.0f;
     }
 
     AlgorithmOutput process(float pitch, float param1, float param2, float param3) {
-        (void)param1;
+        prepare(pitch, param1, param2, param3);
+        AlgorithmOutput output{};
+        processBlock(&output.primary, &output.secondary, 1);
+        return output;
+    }
+
+    void prepare(float pitch, float param1, float param2, float param3) {
+        if (!inputs.changed(pitch, param1, param2, param3)) {
+            return;
+        }
+
         const float pafShift = expoMap(param2, 5.0f, 25.0f);
-        const float mix = std::clamp(param3, 0.0f, 1.0f);
+        // Prev tune: limitedMix 0.4, rawSecondary *0.6, clipAmount 0.8, slewCoeff 0.05, limit 0.5.
+        coeffs.limitedMix = std::clamp(param3, 0.0f, 1.0f) * 0.3f;
+        phase.setFrequency(pitch, sampleRate);
+        formant1Phase.setFrequency(pitch * 2.0f + pafShift, sampleRate);
+    }
 
-        phase = stepPhase(phase, pitch, sampleRate);
-        const float dsf = std::sin(TWO_PI * phase) * 0.5f;
+    void processBlock(float* primary, float* secondary, int frames) {
+        const Coefficients c = coeffs;
+        for (int i = 0; i < frames; ++i) {
+            phase.advance();
+            const float dsf = phase.sine() * 0.5f;
 
-        const float formantFreq = pitch * 2.0f + pafShift;
-        formant1Phase = stepPhase(formant1Phase, formantFreq, sampleRate);
-        const float paf = std::sin(TWO_PI * formant1Phase) * 0.5f;
+            formant1Phase.advance();
+            const float paf = formant1Phase.sine() * 0.5f;
 
-        // Prev tune: limitedMix 0.4, rawSecondary *0.6, clipAmount 0.8, slewCoeff 0.05, limit 0.5.
-        const float limitedMix = mix * 0.3f;
-        const float rawPrimary = dsf * (1.0f - limitedMix) + paf * limitedMix;
-        const float rawSecondary = dsf * 0.5f;
-        const float clipAmount = 0.9f;
-        const float slewCoeff = 0.04f;
-        const float smoothedPrimary = shapeAndSlew(rawPrimary, outPrimary, slewCoeff, clipAmount);
-        const float smoothedSecondary = shapeAndSlew(rawSecondary, outSecondary, slewCoeff, clipAmount);
-        return normalizeOutputLimit(smoothedPrimary, smoothedSecondary, 0.4f);
+            const float rawPrimary = dsf * (1.0f - c.limitedMix) + paf * c.limitedMix;
+            const float rawSecondary = dsf * 0.5f;
+            const float smoothedPrimary = shapeAndSlew(rawPrimary, outPrimary, kSlewCoeff, kClipAmount);
+            const float smoothedSecondary = shapeAndSlew(rawSecondary, outSecondary, kSlewCoeff, kClipAmount);
+            const AlgorithmOutput result = normalizeOutputLimit(smoothedPrimary, smoothedSecondary, kOutputLimit);
+            primary[i] = result.primary;
+            secondary[i] = result.secondary;
+        }
     }
 
 private:
+    static constexpr float kClipAmount = 0.9f;
+    static constexpr float kSlewCoeff = 0.04f;
+    static constexpr float kOutputLimit = 0.4f;
+
+    struct Coefficients {
+        float limitedMix;
+    };
+
     float sampleRate;
-    float phase;
-    float formant1Phase;
+    ControlInputs inputs;
+    Coefficients coeffs{};
+    PhaseAccumulator phase;
+    PhaseAccumulator formant1Phase;
     float outPrimary;
     float outSecondary;
 };
@@ -9,49 +9,84 @@ class Combination7AdaptiveFilterAlgorithm {
 public:
     explicit Combination7AdaptiveFilterAlgorithm(float sampleRate)
         : sampleRate(sampleRate),
-          phase(0.0f),
-          modPhase(0.0f),
-          secondaryPhase(0.0f),
+          phase(),
+          modPhase(),
+          secondaryPhase(),
           outPrimary(0.0f),
           outSecondary(0.0f) {}
 
     void reset() {
-        phase = 0.0f;
-        modPhase = 0.0f;
-        secondaryPhase = 0.0f;
+        phase.reset();
+        modPhase.reset();
+        secondaryPhase.reset();
         outPrimary = 0.0f;
         outSecondary = 0.0f;
     }
 
     AlgorithmOutput process(float pitch, float param1, float param2, float param3) {
+        prepare(pitch, param1, param2, param3);
+        AlgorithmOutput output{};
+        processBlock(&output.primary, &output.secondary, 1);
+        return output;
+    }
+
+    void prepare(float pitch, float param1, float param2, float param3) {
+        if (!inputs.changed(pitch, param1, param2, param3)) {
+            return;
+        }
+
         const float cutoff = param1;
         const float resonance = param2;
-        const float mix = std::clamp(param3, 0.0f, 1.0f);
-
         const float dsfDecay = 0.5f + resonance * 0.3f;
-        phase = stepPhase(phase, pitch, sampleRate);
-        const float theta = TWO_PI * (1.0f + cutoff * 2.0f);
-        const float denom = 1.0f - 2.0f * dsfDecay * std::cos(theta) + dsfDecay * dsfDecay;
-        const float dsf = clampAbs((std::sin(TWO_PI * phase) - dsfDecay * std::sin(TWO_PI * phase - theta))
-            / (denom + EPSILON), 1.0f);
-
-        // Prev tune: DSF + sine mix, raw *0.8, clipAmount 0.4, slewCoeff 0.06, limit 1.0.
-        modPhase = stepPhase(modPhase, pitch, sampleRate);
-        const float mod = std::sin(TWO_PI * modPhase) * 0.5f;
-        const float rawPrimary = (dsf * (1.0f - mix) + mod * mix) * 0.8f;
-        const float rawSecondary = dsf * 0.8f;
-        const float clipAmount = 0.4f;
-        const float slewCoeff = 0.06f;
-        const float smoothedPrimary = shapeAndSlew(rawPrimary, outPrimary, slewCoeff, clipAmount);
-        const float smoothedSecondary = shapeAndSlew(rawSecondary, outSecondary, slewCoeff, clipAmount);
-        return normalizeOutputLimit(smoothedPrimary, smoothedSecondary, 0.9f);
+        const float thetaPhase = 1.0f + cutoff * 2.0f;
+        const float denom = 1.0f - 2.0f * dsfDecay * cosinePhase(thetaPhase) + dsfDecay * dsfDecay;
+
+        coeffs.mix = std::clamp(param3, 0.0f, 1.0f);
+        coeffs.dsfDecay = dsfDecay;
+        coeffs.invDenom = 1.0f / (denom + EPSILON);
+        coeffs.thetaOffset = phaseFromCycles(thetaPhase);
+        phase.setFrequency(pitch, sampleRate);
+        modPhase.setFrequency(pitch, sampleRate);
+    }
+
+    void processBlock(float* primary, float* secondary, int frames) {
+        const Coefficients c = coeffs;
+        for (int i = 0; i < frames; ++i) {
+            phase.advance();
+            const float dsf = clampAbs(
+                (phase.sine() - c.dsfDecay * sineFromPhase(phase.raw() - c.thetaOffset)) * c.invDenom, 1.0f);
+
+            // Prev tune: DSF + sine mix, raw *0.8, clipAmount 0.4, slewCoeff 0.06, limit 1.0.
+            modPhase.advance();
+            const float mod = modPhase.sine() * 0.5f;
+            const float rawPrimary = (dsf * (1.0f - c.mix) + mod * c.mix) * 0.8f;
+            const float rawSecondary = dsf * 0.8f;
+            const float smoothedPrimary = shapeAndSlew(rawPrimary, outPrimary, kSlewCoeff, kClipAmount);
+            const float smoothedSecondary = shapeAndSlew(rawSecondary, outSecondary, kSlewCoeff, kClipAmount);
+            const AlgorithmOutput result = normalizeOutputLimit(smoothedPrimary, smoothedSecondary, kOutputLimit);
+            primary[i] = result.primary;
+            secondary[i] = result.secondary;
+        }
     }
 
 private:
+    static constexpr float kClipAmount = 0.4f;
+    static constexpr float kSlewCoeff = 0.06f;
+    static constexpr float kOutputLimit = 0.9f;
+
+    struct Coefficients {
+        float mix;
+        float dsfDecay;
+        float invDenom;
+        uint32_t thetaOffset;
+    };
+
     float sampleRate;
-    float phase;
-    float modPhase;
-    float secondaryPhase;
+    ControlInputs inputs;
+    Coefficients coeffs{};
+    PhaseAccumulator phase;
+    PhaseAccumulator modPhase;
+    PhaseAccumulator secondaryPhase;
     float outPrimary;
     float outSecondary;
 };
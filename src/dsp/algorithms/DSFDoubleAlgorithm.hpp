@@ -9,51 +9,78 @@ class DSFDoubleAlgorithm {
 public:
     explicit DSFDoubleAlgorithm(float sampleRate)
         : sampleRate(sampleRate),
-          phase(0.0f),
-          secondaryPhase(0.0f),
-          secondaryPhaseNeg(0.0f),
+          phase(),
+          secondaryPhase(),
+          secondaryPhaseNeg(),
           outPrimary(0.0f),
           outSecondary(0.0f) {}
 
     void reset() {
-        phase = 0.0f;
-        secondaryPhase = 0.0f;
-        secondaryPhaseNeg = 0.0f;
+        phase.reset();
+        secondaryPhase.reset();
+        secondaryPhaseNeg.reset();
         outPrimary = 0.0f;
         outSecondary = 0.0f;
     }
 
     AlgorithmOutput process(float pitch, float param1, float param2, float param3) {
+        prepare(pitch, param1, param2, param3);
+        AlgorithmOutput output{};
+        processBlock(&output.primary, &output.secondary, 1);
+        return output;
+    }
+
+    void prepare(float pitch, float param1, float param2, float param3) {
+        if (!inputs.changed(pitch, param1, param2, param3)) {
+            return;
+        }
+
         // Prev tune: sine pair, ratio max 2.0, clipAmount 0.6, slewCoeff 0.08, limit 0.8.
         const float ratio = expoMap(param2, 0.5f, 1.5f);
         const float balance = std::clamp(param3, 0.0f, 1.0f) * 2.0f - 1.0f;
-        const float weightPos = 0.5f + balance * 0.5f;
-        const float weightNeg = 1.0f - weightPos;
-
-        phase = stepPhase(phase, pitch, sampleRate);
-        secondaryPhase = stepPhase(secondaryPhase, pitch * ratio, sampleRate);
-        secondaryPhaseNeg = stepPhase(secondaryPhaseNeg, pitch * ratio, sampleRate);
-
-        const float tPos = secondaryPhase * TWO_PI;
-        const float tNeg = -secondaryPhaseNeg * TWO_PI;
-
-        const float positive = std::sin(tPos) * 0.4f;
-        const float negative = std::sin(tNeg) * 0.4f;
-
-        const float rawPrimary = 0.5f * (positive * weightPos + negative * weightNeg);
-        const float rawSecondary = 0.5f * (positive - negative);
-        const float clipAmount = 0.7f;
-        const float slewCoeff = 0.06f;
-        const float smoothedPrimary = shapeAndSlew(rawPrimary, outPrimary, slewCoeff, clipAmount);
-        const float smoothedSecondary = shapeAndSlew(rawSecondary, outSecondary, slewCoeff, clipAmount);
-        return normalizeOutputLimit(smoothedPrimary, smoothedSecondary, 0.6f);
+        coeffs.weightPos = 0.5f + balance * 0.5f;
+        coeffs.weightNeg = 1.0f - coeffs.weightPos;
+        phase.setFrequency(pitch, sampleRate);
+        secondaryPhase.setFrequency(pitch * ratio, sampleRate);
+        secondaryPhaseNeg.setFrequency(pitch * ratio, sampleRate);
+    }
+
+    void processBlock(float* primary, float* secondary, int frames) {
+        const Coefficients c = coeffs;
+        for (int i = 0; i < frames; ++i) {
+            phase.advance();
+            secondaryPhase.advance();
+            secondaryPhaseNeg.advance();
+
+            const float positive = secondaryPhase.sine() * 0.4f;
+            const float negative = sineFromPhase(0u - secondaryPhaseNeg.raw()) * 0.4f;
+
+            const float rawPrimary = 0.5f * (positive * c.weightPos + negative * c.weightNeg);
+            const float rawSecondary = 0.5f * (positive - negative);
+            const float smoothedPrimary = shapeAndSlew(rawPrimary, outPrimary, kSlewCoeff, kClipAmount);
+            const float smoothedSecondary = shapeAndSlew(rawSecondary, outSecondary, kSlewCoeff, kClipAmount);
+            const AlgorithmOutput result = normalizeOutputLimit(smoothedPrimary, smoothedSecondary, kOutputLimit);
+            primary[i] = result.primary;
+            secondary[i] = result.secondary;
+        }
     }
 
 private:
+    static constexpr float kClipAmount = 0.7f;
+    static constexpr float kSlewCoeff = 0.06f;
+    static constexpr float kOutputLimit = 0.6f;
+
+    struct Coefficients {
+        float weightPos;
+        float weightNeg;
+    };
+
     float sampleRate;
-    float phase;
-    float secondaryPhase;
-    float secondaryPhaseNeg;
+    ControlInputs inputs;
+    Coefficients coeffs{};
+    PhaseAccumulator phase;
+    PhaseAccumulator secondaryPhase;
+    PhaseAccumulator secondaryPhaseNeg;
     float outPrimary;
     float outSecondary;
 };
@@ -8,41 +8,66 @@ namespace flues::disyn {
 class DSFSingleAlgorithm {
 public:
     explicit DSFSingleAlgorithm(float sampleRate)
-        : sampleRate(sampleRate), phase(0.0f), secondaryPhase(0.0f), outPrimary(0.0f), outSecondary(0.0f) {}
+        : sampleRate(sampleRate), phase(), secondaryPhase(), outPrimary(0.0f), outSecondary(0.0f) {}
 
     void reset() {
-        phase = 0.0f;
-        secondaryPhase = 0.0f;
+        phase.reset();
+        secondaryPhase.reset();
         outPrimary = 0.0f;
         outSecondary = 0.0f;
     }
 
     AlgorithmOutput process(float pitch, float param1, float param2, float param3) {
+        prepare(pitch, param1, param2, param3);
+        AlgorithmOutput output{};
+        processBlock(&output.primary, &output.secondary, 1);
+        return output;
+    }
+
+    void prepare(float pitch, float param1, float param2, float param3) {
+        if (!inputs.changed(pitch, param1, param2, param3)) {
+            return;
+        }
+
         // Prev tune: sine blend, ratio max 2.0, clipAmount 0.6, slewCoeff 0.06, limit 0.8.
         const float ratio = expoMap(param2, 0.5f, 1.5f);
-        const float mix = std::clamp(param3, 0.0f, 1.0f);
-
-        phase = stepPhase(phase, pitch, sampleRate);
-        secondaryPhase = stepPhase(secondaryPhase, pitch * ratio, sampleRate);
-
-        const float w = phase * TWO_PI;
-        const float t = secondaryPhase * TWO_PI;
-
-        const float carrier = std::sin(w) * 0.4f;
-        const float mod = std::sin(t) * 0.4f;
-        const float rawPrimary = carrier * (1.0f - mix) + mod * mix;
-        const float rawSecondary = carrier * 0.5f;
-        const float clipAmount = 0.7f;
-        const float slewCoeff = 0.05f;
-        const float smoothedPrimary = shapeAndSlew(rawPrimary, outPrimary, slewCoeff, clipAmount);
-        const float smoothedSecondary = shapeAndSlew(rawSecondary, outSecondary, slewCoeff, clipAmount);
-        return normalizeOutputLimit(smoothedPrimary, smoothedSecondary, 0.6f);
+        coeffs.mix = std::clamp(param3, 0.0f, 1.0f);
+        phase.setFrequency(pitch, sampleRate);
+        secondaryPhase.setFrequency(pitch * ratio, sampleRate);
+    }
+
+    void processBlock(float* primary, float* secondary, int frames) {
+        const Coefficients c = coeffs;
+        for (int i = 0; i < frames; ++i) {
+            phase.advance();
+            secondaryPhase.advance();
+
+            const float carrier = phase.sine() * 0.4f;
+            const float mod = secondaryPhase.sine() * 0.4f;
+            const float rawPrimary = carrier * (1.0f - c.mix) + mod * c.mix;
+            const float rawSecondary = carrier * 0.5f;
+            const float smoothedPrimary = shapeAndSlew(rawPrimary, outPrimary, kSlewCoeff, kClipAmount);
+            const float smoothedSecondary = shapeAndSlew(rawSecondary, outSecondary, kSlewCoeff, kClipAmount);
+            const AlgorithmOutput result = normalizeOutputLimit(smoothedPrimary, smoothedSecondary, kOutputLimit);
+            primary[i] = result.primary;
+            secondary[i] = result.secondary;
+        }
     }
 
 private:
+    static constexpr float kClipAmount = 0.7f;
+    static constexpr float kSlewCoeff = 0.05f;
+    static constexpr float kOutputLimit = 0.6f;
+
+    struct Coefficients {
+        float mix;
+    };
+
     float sampleRate;
-    float phase;
-    float secondaryPhase;
+    ControlInputs inputs;
+    Coefficients coeffs{};
+    PhaseAccumulator phase;
+    PhaseAccumulator secondaryPhase;
     float outPrimary;
     float outSecondary;
 };
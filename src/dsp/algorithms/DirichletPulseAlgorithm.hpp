@@ -8,50 +8,101 @@ namespace flues::disyn {
 class DirichletPulseAlgorithm {
 public:
     explicit DirichletPulseAlgorithm(float sampleRate)
-        : sampleRate(sampleRate), phase(0.0f), outPrimary(0.0f), outSecondary(0.0f) {}
+        : sampleRate(sampleRate), phase(), outPrimary(0.0f), outSecondary(0.0f) {}
 
     void reset() {
-        phase = 0.0f;
+        phase.reset();
         outPrimary = 0.0f;
         outSecondary = 0.0f;
     }
 
     AlgorithmOutput process(float pitch, float param1, float param2, float param3) {
+        prepare(pitch, param1, param2, param3);
+        AlgorithmOutput output{};
+        processBlock(&output.primary, &output.secondary, 1);
+        return output;
+    }
+
+    void prepare(float pitch, float param1, float param2, float param3) {
+        if (!inputs.changed(pitch, param1, param2, param3)) {
+            return;
+        }
+
         // Prev tune: harmonics up to 32, tilt -6..+6 dB, denom min 1e-2, limit base 1.0.
         const int harmonics = std::max(1, static_cast<int>(std::round(1.0f + param1 * 31.0f)));
         const float tilt = -6.0f + param2 * 12.0f;
         const float shape = std::clamp(param3, 0.0f, 1.0f);
+        coeffs.harmonicOrder = static_cast<uint32_t>(2 * harmonics + 1);
+        coeffs.baseScale = std::pow(10.0f, tilt / 20.0f) / static_cast<float>(harmonics);
+        coeffs.shape = shape;
+        coeffs.shapeDrive = 1.0f + shape * 4.0f;
+        phase.setFrequency(pitch, sampleRate);
+    }
 
-        phase = stepPhase(phase, pitch, sampleRate);
-        const float theta = phase * TWO_PI;
+    void processBlock(float* primary, float* secondary, int frames) {
+        const Coefficients c = coeffs;
+        for (int i = 0; i < frames; ++i) {
+            phase.advance();
+            const AlgorithmOutput result = kernel(c, phase.raw(), outPrimary, outSecondary);
+            primary[i] = result.primary;
+            secondary[i] = result.secondary;
+        }
+    }
 
-        const float numerator = std::sin((2.0f * harmonics + 1.0f) * theta * 0.5f);
-        const float denominator = std::sin(theta * 0.5f);
+    struct Coefficients {
+        uint32_t harmonicOrder; // 2N+1, always odd
+        float baseScale;
+        float shape;
+        float shapeDrive;
+    };
 
-        float value;
-        if (std::abs(denominator) < 1e-2f) {
-            const float safeDenom = (denominator < 0.0f ? -1e-2f : 1e-2f);
-            value = (numerator / safeDenom) - 1.0f;
-        } else {
-            value = (numerator / denominator) - 1.0f;
-        }
+    const Coefficients& coefficients() const {
+        return coeffs;
+    }
+
+    static AlgorithmOutput kernel(const Coefficients& c, uint32_t phase, float& slewPrimary,
+                                  float& slewSecondary) {
+        // Half-angle phases: (2N+1) * theta / 2 and theta / 2, computed exactly in fixed point.
+        // With phase = 2h + b, ((2N+1) * phase) >> 1 = (2N+1) * h + b * N, so 32-bit products
+        // give the same bits as the 64-bit one and vectorise.
+        const uint32_t halfOrderPhase = c.harmonicOrder * (phase >> 1) + (phase & 1u) * (c.harmonicOrder >> 1);
+        const float numerator = sineFromPhase(halfOrderPhase);
+        const float denominator = sineFromPhase(phase >> 1);
 
-        const float tiltFactor = std::pow(10.0f, tilt / 20.0f);
-        const float base = (value / static_cast<float>(harmonics)) * tiltFactor;
+        // Selects rather than a branch, so that unison lanes can run side by side.
+        const float guard = denominator < 0.0f ? -1e-2f : 1e-2f;
+        const float safeDenom = std::abs(denominator) < 1e-2f ? guard : denominator;
+        const float value = (numerator / safeDenom) - 1.0f;
+
+        const float base = value * c.baseScale;
         const float limitedBase = clampAbs(base, 1.0f);
-        const float shaped = std::tanh(limitedBase * (1.0f + shape * 4.0f));
-        const float rawPrimary = limitedBase * (1.0f - shape) + shaped * shape;
+        const float shaped = fastTanh(limitedBase * c.shapeDrive);
+        const float rawPrimary = limitedBase * (1.0f - c.shape) + shaped * c.shape;
         const float rawSecondary = limitedBase;
-        const float clipAmount = 0.7f;
-        const float slewCoeff = 0.05f;
-        const float smoothedPrimary = shapeAndSlew(rawPrimary, outPrimary, slewCoeff, clipAmount);
-        const float smoothedSecondary = shapeAndSlew(rawSecondary, outSecondary, slewCoeff, clipAmount);
-        return normalizeOutputLimit(smoothedPrimary, smoothedSecondary, 0.4f);
+        const float smoothedPrimary = shapeAndSlew(rawPrimary, slewPrimary, kSlewCoeff, kClipAmount);
+        const float smoothedSecondary = shapeAndSlew(rawSecondary, slewSecondary, kSlewCoeff, kClipAmount);
+        return normalizeOutputLimit(smoothedPrimary, smoothedSecondary, kOutputLimit);
+    }
+
+    LaneState laneState() const {
+        return {phase.raw(), outPrimary, outSecondary};
+    }
+
+    void setLaneState(const LaneState& state) {
+        phase.setRaw(state.phase);
+        outPrimary = state.slewPrimary;
+        outSecondary = state.slewSecondary;
     }
 
 private:
+    static constexpr float kClipAmount = 0.7f;
+    static constexpr float kSlewCoeff = 0.05f;
+    static constexpr float kOutputLimit = 0.4f;
+
     float sampleRate;
-    float phase;
+    ControlInputs inputs;
+    Coefficients coeffs{};
+    PhaseAccumulator phase;
     float outPrimary;
     float outSecondary;
 };
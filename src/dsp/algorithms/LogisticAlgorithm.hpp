@@ -9,41 +9,57 @@ class LogisticAlgorithm {
 public:
     explicit LogisticAlgorithm(float sampleRate)
         : sampleRate(sampleRate),
-          phase(0.0f),
-          lastPhase(0.0f),
+          phase(),
           x(0.37f),
           smoothed(0.0f) {}
 
     void reset() {
-        phase = 0.0f;
-        lastPhase = 0.0f;
+        phase.reset();
         x = 0.37f;
         smoothed = 0.0f;
     }
 
     AlgorithmOutput process(float pitch, float param1, float param2, float param3) {
-        (void)param2;
-        (void)param3;
-        const float smoothing = std::clamp(param1, 0.0f, 1.0f);
-        const float slewCoeff = 0.02f + (1.0f - smoothing) * 0.18f;
+        prepare(pitch, param1, param2, param3);
+        AlgorithmOutput output{};
+        processBlock(&output.primary, &output.secondary, 1);
+        return output;
+    }
 
-        phase = stepPhase(phase, pitch, sampleRate);
-        if (phase < lastPhase) {
-            const float r = 3.9f;
-            x = r * x * (1.0f - x);
-            x = std::clamp(x, 0.0001f, 0.9999f);
+    void prepare(float pitch, float param1, float param2, float param3) {
+        if (!inputs.changed(pitch, param1, param2, param3)) {
+            return;
         }
-        lastPhase = phase;
 
-        const float raw = x * 2.0f - 1.0f;
-        const float output = slewLimit(raw, smoothed, slewCoeff);
-        return {output, raw};
+        const float smoothing = std::clamp(param1, 0.0f, 1.0f);
+        coeffs.slewCoeff = 0.02f + (1.0f - smoothing) * 0.18f;
+        phase.setFrequency(pitch, sampleRate);
+    }
+
+    void processBlock(float* primary, float* secondary, int frames) {
+        const Coefficients c = coeffs;
+        for (int i = 0; i < frames; ++i) {
+            if (phase.advance()) {
+                const float r = 3.9f;
+                x = r * x * (1.0f - x);
+                x = std::clamp(x, 0.0001f, 0.9999f);
+            }
+
+            const float raw = x * 2.0f - 1.0f;
+            primary[i] = slewLimit(raw, smoothed, c.slewCoeff);
+            secondary[i] = raw;
+        }
     }
 
 private:
+    struct Coefficients {
+        float slewCoeff;
+    };
+
     float sampleRate;
-    float phase;
-    float lastPhase;
+    ControlInputs inputs;
+    Coefficients coeffs{};
+    PhaseAccumulator phase;
     float x;
     float smoothed;
 };
@@ -11,33 +11,44 @@ class NoiseAlgorithm {
 public:
     explicit NoiseAlgorithm(float sampleRate)
         : sampleRate(sampleRate),
-          phase(0.0f),
-          lastPhase(0.0f),
+          phase(),
           noiseValue(0.0f),
           smoothed(0.0f),
           rngState(0x6d2b79f5u) {}
 
     void reset() {
-        phase = 0.0f;
-        lastPhase = 0.0f;
+        phase.reset();
         noiseValue = 0.0f;
         smoothed = 0.0f;
     }
 
     AlgorithmOutput process(float pitch, float param1, float param2, float param3) {
-        (void)param2;
-        (void)param3;
-        const float smoothing = std::clamp(param1, 0.0f, 1.0f);
-        const float slewCoeff = 0.02f + (1.0f - smoothing) * 0.98f;
+        prepare(pitch, param1, param2, param3);
+        AlgorithmOutput output{};
+        processBlock(&output.primary, &output.secondary, 1);
+        return output;
+    }
 
-        phase = stepPhase(phase, pitch, sampleRate);
-        if (phase < lastPhase) {
-            noiseValue = nextNoise();
+    void prepare(float pitch, float param1, float param2, float param3) {
+        if (!inputs.changed(pitch, param1, param2, param3)) {
+            return;
         }
-        lastPhase = phase;
 
-        const float output = slewLimit(noiseValue, smoothed, slewCoeff);
-        return {output, noiseValue};
+        const float smoothing = std::clamp(param1, 0.0f, 1.0f);
+        coeffs.slewCoeff = 0.02f + (1.0f - smoothing) * 0.98f;
+        phase.setFrequency(pitch, sampleRate);
+    }
+
+    void processBlock(float* primary, float* secondary, int frames) {
+        const Coefficients c = coeffs;
+        for (int i = 0; i < frames; ++i) {
+            if (phase.advance()) {
+                noiseValue = nextNoise();
+            }
+
+            primary[i] = slewLimit(noiseValue, smoothed, c.slewCoeff);
+            secondary[i] = noiseValue;
+        }
     }
 
 private:
@@ -47,9 +58,14 @@ private:
         return static_cast<float>(sample) / 8388607.5f - 1.0f;
     }
 
+    struct Coefficients {
+        float slewCoeff;
+    };
+
     float sampleRate;
-    float phase;
-    float lastPhase;
+    ControlInputs inputs;
+    Coefficients coeffs{};
+    PhaseAccumulator phase;
     float noiseValue;
     float smoothed;
     uint32_t rngState;
@@ -9,46 +9,74 @@ class Novel1MultistageAlgorithm {
 public:
     explicit Novel1MultistageAlgorithm(float sampleRate)
         : sampleRate(sampleRate),
-          phase(0.0f),
-          modPhase(0.0f),
+          phase(),
+          modPhase(),
           outPrimary(0.0f),
           outSecondary(0.0f) {}
 
     void reset() {
-        phase = 0.0f;
-        modPhase = 0.0f;
+        phase.reset();
+        modPhase.reset();
         outPrimary = 0.0f;
         outSecondary = 0.0f;
     }
 
     AlgorithmOutput process(float pitch, float param1, float param2, float param3) {
-        const float tanhDrive = expoMap(param1, 0.1f, 3.0f);
+        prepare(pitch, param1, param2, param3);
+        AlgorithmOutput output{};
+        processBlock(&output.primary, &output.secondary, 1);
+        return output;
+    }
+
+    void prepare(float pitch, float param1, float param2, float param3) {
+        if (!inputs.changed(pitch, param1, param2, param3)) {
+            return;
+        }
+
+        coeffs.tanhDrive = expoMap(param1, 0.1f, 3.0f);
         const float ringCarrierMult = 0.5f + param3 * 1.5f;
+        phase.setFrequency(pitch, sampleRate);
+        modPhase.setFrequency(pitch * ringCarrierMult, sampleRate);
+    }
 
-        phase = stepPhase(phase, pitch, sampleRate);
-        const float input = std::sin(TWO_PI * phase);
+    void processBlock(float* primary, float* secondary, int frames) {
+        const Coefficients c = coeffs;
+        for (int i = 0; i < frames; ++i) {
+            phase.advance();
+            const float input = phase.sine();
 
-        const float stage1 = std::tanh(tanhDrive * input);
-        const float stage2 = stage1;
+            const float stage1 = fastTanh(c.tanhDrive * input);
+            const float stage2 = stage1;
 
-        modPhase = stepPhase(modPhase, pitch * ringCarrierMult, sampleRate);
-        const float carrier = std::sin(TWO_PI * modPhase);
-        const float stage3 = stage2 * (1.0f + carrier);
+            modPhase.advance();
+            const float carrier = modPhase.sine();
+            const float stage3 = stage2 * (1.0f + carrier);
 
-        // Prev tune: raw *0.8, clipAmount 0.7, slewCoeff 0.05, limit 0.5.
-        const float rawPrimary = stage3 * 1.2f;
-        const float rawSecondary = stage2 * 1.2f;
-        const float clipAmount = 0.5f;
-        const float slewCoeff = 0.06f;
-        const float smoothedPrimary = shapeAndSlew(rawPrimary, outPrimary, slewCoeff, clipAmount);
-        const float smoothedSecondary = shapeAndSlew(rawSecondary, outSecondary, slewCoeff, clipAmount);
-        return normalizeOutputLimit(smoothedPrimary, smoothedSecondary, 1.0f);
+            // Prev tune: raw *0.8, clipAmount 0.7, slewCoeff 0.05, limit 0.5.
+            const float rawPrimary = stage3 * 1.2f;
+            const float rawSecondary = stage2 * 1.2f;
+            const float smoothedPrimary = shapeAndSlew(rawPrimary, outPrimary, kSlewCoeff, kClipAmount);
+            const float smoothedSecondary = shapeAndSlew(rawSecondary, outSecondary, kSlewCoeff, kClipAmount);
+            const AlgorithmOutput result = normalizeOutputLimit(smoothedPrimary, smoothedSecondary, kOutputLimit);
+            primary[i] = result.primary;
+            secondary[i] = result.secondary;
+        }
     }
 
 private:
+    static constexpr float kClipAmount = 0.5f;
+    static constexpr float kSlewCoeff = 0.06f;
+    static constexpr float kOutputLimit = 1.0f;
+
+    struct Coefficients {
+        float tanhDrive;
+    };
+
     float sampleRate;
-    float phase;
-    float modPhase;
+    ControlInputs inputs;
+    Coefficients coeffs{};
+    PhaseAccumulator phase;
+    PhaseAccumulator modPhase;
     float outPrimary;
     float outSecondary;
 };
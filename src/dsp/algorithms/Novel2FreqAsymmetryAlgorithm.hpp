@@ -9,19 +9,30 @@ class Novel2FreqAsymmetryAlgorithm {
 public:
     explicit Novel2FreqAsymmetryAlgorithm(float sampleRate)
         : sampleRate(sampleRate),
-          phase(0.0f),
-          modPhase(0.0f),
+          phase(),
+          modPhase(),
           outPrimary(0.0f),
           outSecondary(0.0f) {}
 
     void reset() {
-        phase = 0.0f;
-        modPhase = 0.0f;
+        phase.reset();
+        modPhase.reset();
         outPrimary = 0.0f;
         outSecondary = 0.0f;
     }
 
     AlgorithmOutput process(float pitch, float param1, float param2, float param3) {
+        prepare(pitch, param1, param2, param3);
+        AlgorithmOutput output{};
+        processBlock(&output.primary, &output.secondary, 1);
+        return output;
+    }
+
+    void prepare(float pitch, float param1, float param2, float param3) {
+        if (!inputs.changed(pitch, param1, param2, param3)) {
+            return;
+        }
+
         const float lowR = 0.8f + param1 * 0.2f;
         const float highR = 1.0f + param2 * 0.2f;
         const float index = 0.1f + std::clamp(param3, 0.0f, 1.0f) * 0.3f;
@@ -35,24 +46,42 @@ public:
             const float alpha = (pitch - 500.0f) / 1500.0f;
             r = lowR * (1.0f - alpha) + highR * alpha;
         }
+        coeffs.indexPhase = index * INV_TWO_PI;
+        phase.setFrequency(pitch, sampleRate);
+        modPhase.setFrequency(pitch * r, sampleRate);
+    }
 
-        modPhase = stepPhase(modPhase, pitch * r, sampleRate);
-        phase = stepPhase(phase, pitch, sampleRate);
-        const float mod = std::sin(TWO_PI * modPhase);
-        const float output = std::cos(TWO_PI * phase + mod * index) * 0.4f;
-        const float secondary = std::cos(TWO_PI * phase) * 0.4f;
-        // Prev tune: output *1.0, clipAmount 0.5, slewCoeff 0.05, limit 0.6.
-        const float clipAmount = 0.3f;
-        const float slewCoeff = 0.06f;
-        const float smoothedPrimary = shapeAndSlew(output * 1.5f, outPrimary, slewCoeff, clipAmount);
-        const float smoothedSecondary = shapeAndSlew(secondary * 1.5f, outSecondary, slewCoeff, clipAmount);
-        return normalizeOutputLimit(smoothedPrimary, smoothedSecondary, 1.2f);
+    void processBlock(float* primary, float* secondary, int frames) {
+        const Coefficients c = coeffs;
+        for (int i = 0; i < frames; ++i) {
+            modPhase.advance();
+            phase.advance();
+            const float mod = modPhase.sine();
+            const float output = cosinePhase(phase.value() + mod * c.indexPhase) * 0.4f;
+            const float secondaryOut = phase.cosine() * 0.4f;
+            // Prev tune: output *1.0, clipAmount 0.5, slewCoeff 0.05, limit 0.6.
+            const float smoothedPrimary = shapeAndSlew(output * 1.5f, outPrimary, kSlewCoeff, kClipAmount);
+            const float smoothedSecondary = shapeAndSlew(secondaryOut * 1.5f, outSecondary, kSlewCoeff, kClipAmount);
+            const AlgorithmOutput result = normalizeOutputLimit(smoothedPrimary, smoothedSecondary, kOutputLimit);
+            primary[i] = result.primary;
+            secondary[i] = result.secondary;
+        }
     }
 
 private:
+    static constexpr float kClipAmount = 0.3f;
+    static constexpr float kSlewCoeff = 0.06f;
+    static constexpr float kOutputLimit = 1.2f;
+
+    struct Coefficients {
+        float indexPhase;
+    };
+
     float sampleRate;
-    float phase;
-    float modPhase;
+    ControlInputs inputs;
+    Coefficients coeffs{};
+    PhaseAccumulator phase;
+    PhaseAccumulator modPhase;
     float outPrimary;
     float outSecondary;
 };
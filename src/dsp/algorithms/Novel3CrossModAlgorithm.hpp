@@ -9,47 +9,73 @@ class Novel3CrossModAlgorithm {
 public:
     explicit Novel3CrossModAlgorithm(float sampleRate)
         : sampleRate(sampleRate),
-          phase(0.0f),
-          modPhase(0.0f),
-          secondaryPhase(0.0f),
+          phase(),
+          modPhase(),
+          secondaryPhase(),
           outPrimary(0.0f),
           outSecondary(0.0f) {}
 
     void reset() {
-        phase = 0.0f;
-        modPhase = 0.0f;
-        secondaryPhase = 0.0f;
+        phase.reset();
+        modPhase.reset();
+        secondaryPhase.reset();
         outPrimary = 0.0f;
         outSecondary = 0.0f;
     }
 
     AlgorithmOutput process(float pitch, float param1, float param2, float param3) {
+        prepare(pitch, param1, param2, param3);
+        AlgorithmOutput output{};
+        processBlock(&output.primary, &output.secondary, 1);
+        return output;
+    }
+
+    void prepare(float pitch, float param1, float param2, float param3) {
+        if (!inputs.changed(pitch, param1, param2, param3)) {
+            return;
+        }
+
         const float mod1Depth = param1;
-        const float mod2Depth = param2;
-        (void)mod2Depth;
-        const float mix = std::clamp(param3, 0.0f, 1.0f);
-
-        // Prev tune: sine crossfade, raw *0.8, clipAmount 0.6, slewCoeff 0.06, limit 0.6.
-        phase = stepPhase(phase, pitch, sampleRate);
-        modPhase = stepPhase(modPhase, pitch * (1.0f + mod1Depth), sampleRate);
-
-        const float carrier = std::sin(TWO_PI * phase);
-        const float mod = std::sin(TWO_PI * modPhase);
-
-        const float rawPrimary = (carrier * (1.0f - mix) + mod * mix) * 1.4f;
-        const float rawSecondary = carrier * 1.4f;
-        const float clipAmount = 0.3f;
-        const float slewCoeff = 0.07f;
-        const float smoothedPrimary = shapeAndSlew(rawPrimary, outPrimary, slewCoeff, clipAmount);
-        const float smoothedSecondary = shapeAndSlew(rawSecondary, outSecondary, slewCoeff, clipAmount);
-        return normalizeOutputLimit(smoothedPrimary, smoothedSecondary, 1.2f);
+        coeffs.mix = std::clamp(param3, 0.0f, 1.0f);
+        phase.setFrequency(pitch, sampleRate);
+        modPhase.setFrequency(pitch * (1.0f + mod1Depth), sampleRate);
+    }
+
+    void processBlock(float* primary, float* secondary, int frames) {
+        const Coefficients c = coeffs;
+        for (int i = 0; i < frames; ++i) {
+            // Prev tune: sine crossfade, raw *0.8, clipAmount 0.6, slewCoeff 0.06, limit 0.6.
+            phase.advance();
+            modPhase.advance();
+
+            const float carrier = phase.sine();
+            const float mod = modPhase.sine();
+
+            const float rawPrimary = (carrier * (1.0f - c.mix) + mod * c.mix) * 1.4f;
+            const float rawSecondary = carrier * 1.4f;
+            const float smoothedPrimary = shapeAndSlew(rawPrimary, outPrimary, kSlewCoeff, kClipAmount);
+            const float smoothedSecondary = shapeAndSlew(rawSecondary, outSecondary, kSlewCoeff, kClipAmount);
+            const AlgorithmOutput result = normalizeOutputLimit(smoothedPrimary, smoothedSecondary, kOutputLimit);
+            primary[i] = result.primary;
+            secondary[i] = result.secondary;
+        }
     }
 
 private:
+    static constexpr float kClipAmount = 0.3f;
+    static constexpr float kSlewCoeff = 0.07f;
+    static constexpr float kOutputLimit = 1.2f;
+
+    struct Coefficients {
+        float mix;
+    };
+
     float sampleRate;
-    float phase;
-    float modPhase;
-    float secondaryPhase;
+    ControlInputs inputs;
+    Coefficients coeffs{};
+    PhaseAccumulator phase;
+    PhaseAccumulator modPhase;
+    PhaseAccumulator secondaryPhase;
     float outPrimary;
     float outSecondary;
 };
@@ -8,39 +8,87 @@ namespace flues::disyn {
 class Novel4TaylorAlgorithm {
 public:
     explicit Novel4TaylorAlgorithm(float sampleRate)
-        : sampleRate(sampleRate), phase(0.0f), outPrimary(0.0f), outSecondary(0.0f) {}
+        : sampleRate(sampleRate), phase(), outPrimary(0.0f), outSecondary(0.0f) {}
 
     void reset() {
-        phase = 0.0f;
+        phase.reset();
         outPrimary = 0.0f;
         outSecondary = 0.0f;
     }
 
     AlgorithmOutput process(float pitch, float param1, float param2, float param3) {
-        const int firstTerms = std::max(1, static_cast<int>(std::round(1.0f + param1 * 9.0f)));
-        const int secondTerms = std::max(1, static_cast<int>(std::round(1.0f + param2 * 9.0f)));
-        const float blend = std::clamp(param3, 0.0f, 1.0f);
+        prepare(pitch, param1, param2, param3);
+        AlgorithmOutput output{};
+        processBlock(&output.primary, &output.secondary, 1);
+        return output;
+    }
+
+    void prepare(float pitch, float param1, float param2, float param3) {
+        if (!inputs.changed(pitch, param1, param2, param3)) {
+            return;
+        }
+
+        coeffs.firstTerms = std::max(1, static_cast<int>(std::round(1.0f + param1 * 9.0f)));
+        coeffs.secondTerms = std::max(1, static_cast<int>(std::round(1.0f + param2 * 9.0f)));
+        coeffs.blend = std::clamp(param3, 0.0f, 1.0f);
+        phase.setFrequency(pitch, sampleRate);
+    }
+
+    void processBlock(float* primary, float* secondary, int frames) {
+        const Coefficients c = coeffs;
+        for (int i = 0; i < frames; ++i) {
+            phase.advance();
+            const AlgorithmOutput result = kernel(c, phase.raw(), outPrimary, outSecondary);
+            primary[i] = result.primary;
+            secondary[i] = result.secondary;
+        }
+    }
+
+    struct Coefficients {
+        int firstTerms;
+        int secondTerms;
+        float blend;
+    };
 
-        phase = stepPhase(phase, pitch, sampleRate);
-        const float theta = phase * TWO_PI;
+    const Coefficients& coefficients() const {
+        return coeffs;
+    }
+
+    static AlgorithmOutput kernel(const Coefficients& c, uint32_t phase, float& slewPrimary,
+                                  float& slewSecondary) {
+        const float theta = cyclesFromPhase(phase) * TWO_PI;
 
-        const float fundamental = computeTaylorSine(theta, firstTerms);
-        const float secondHarmonic = computeTaylorSine(2.0f * theta, secondTerms);
+        const float fundamental = computeTaylorSine(theta, c.firstTerms);
+        const float secondHarmonic = computeTaylorSine(2.0f * theta, c.secondTerms);
 
-        const float output = fundamental * (1.0f - blend) + secondHarmonic * blend;
+        const float output = fundamental * (1.0f - c.blend) + secondHarmonic * c.blend;
         const float clamped = std::clamp(output, -1.0f, 1.0f);
-        const float secondary = std::clamp(secondHarmonic, -1.0f, 1.0f);
+        const float secondaryOut = std::clamp(secondHarmonic, -1.0f, 1.0f);
         // Prev tune: clipAmount 0.8, slewCoeff 0.06, limit 0.8.
-        const float clipAmount = 0.9f;
-        const float slewCoeff = 0.05f;
-        const float smoothedPrimary = shapeAndSlew(clamped, outPrimary, slewCoeff, clipAmount);
-        const float smoothedSecondary = shapeAndSlew(secondary, outSecondary, slewCoeff, clipAmount);
-        return normalizeOutputLimit(smoothedPrimary, smoothedSecondary, 0.6f);
+        const float smoothedPrimary = shapeAndSlew(clamped, slewPrimary, kSlewCoeff, kClipAmount);
+        const float smoothedSecondary = shapeAndSlew(secondaryOut, slewSecondary, kSlewCoeff, kClipAmount);
+        return normalizeOutputLimit(smoothedPrimary, smoothedSecondary, kOutputLimit);
+    }
+
+    LaneState laneState() const {
+        return {phase.raw(), outPrimary, outSecondary};
+    }
+
+    void setLaneState(const LaneState& state) {
+        phase.setRaw(state.phase);
+        outPrimary = state.slewPrimary;
+        outSecondary = state.slewSecondary;
     }
 
 private:
+    static constexpr float kClipAmount = 0.9f;
+    static constexpr float kSlewCoeff = 0.05f;
+    static constexpr float kOutputLimit = 0.6f;
+
     float sampleRate;
-    float phase;
+    ControlInputs inputs;
+    Coefficients coeffs{};
+    PhaseAccumulator phase;
     float outPrimary;
     float outSecondary;
 };
@@ -8,26 +8,65 @@ namespace flues::disyn {
 class SineAlgorithm {
 public:
     explicit SineAlgorithm(float sampleRate)
-        : sampleRate(sampleRate), phase(0.0f) {}
+        : sampleRate(sampleRate), phase() {}
 
     void reset() {
-        phase = 0.0f;
+        phase.reset();
     }
 
     AlgorithmOutput process(float pitch, float param1, float param2, float param3) {
-        (void)param2;
-        (void)param3;
-        const int steps = 1 + static_cast<int>(std::round(std::clamp(param1, 0.0f, 1.0f) * 63.0f));
+        prepare(pitch, param1, param2, param3);
+        AlgorithmOutput output{};
+        processBlock(&output.primary, &output.secondary, 1);
+        return output;
+    }
+
+    void prepare(float pitch, float param1, float param2, float param3) {
+        if (!inputs.changed(pitch, param1, param2, param3)) {
+            return;
+        }
+
+        coeffs.quantizer.setSteps(1 + static_cast<int>(std::round(std::clamp(param1, 0.0f, 1.0f) * 63.0f)));
+        phase.setFrequency(pitch, sampleRate);
+    }
+
+    void processBlock(float* primary, float* secondary, int frames) {
+        const Coefficients c = coeffs;
+        float noSlew = 0.0f;
+        for (int i = 0; i < frames; ++i) {
+            phase.advance();
+            const AlgorithmOutput result = kernel(c, phase.raw(), noSlew, noSlew);
+            primary[i] = result.primary;
+            secondary[i] = result.secondary;
+        }
+    }
+
+    struct Coefficients {
+        BipolarQuantizer quantizer;
+    };
 
-        phase = stepPhase(phase, pitch, sampleRate);
-        float value = std::sin(TWO_PI * phase);
-        value = quantizeBipolar(value, steps);
+    const Coefficients& coefficients() const {
+        return coeffs;
+    }
+
+    static AlgorithmOutput kernel(const Coefficients& c, uint32_t phase, float&, float&) {
+        const float value = c.quantizer.apply(sineFromPhase(phase));
         return {value, value};
     }
 
+    LaneState laneState() const {
+        return {phase.raw(), 0.0f, 0.0f};
+    }
+
+    void setLaneState(const LaneState& state) {
+        phase.setRaw(state.phase);
+    }
+
 private:
     float sampleRate;
-    float phase;
+    ControlInputs inputs;
+    Coefficients coeffs{};
+    PhaseAccumulator phase;
 };
 
 } // namespace flues::disyn
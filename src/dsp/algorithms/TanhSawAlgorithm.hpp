@@ -9,47 +9,77 @@ class TanhSawAlgorithm {
 public:
     explicit TanhSawAlgorithm(float sampleRate)
         : sampleRate(sampleRate),
-          phase(0.0f),
-          secondaryPhase(0.0f),
+          phase(),
+          secondaryPhase(),
           outPrimary(0.0f),
           outSecondary(0.0f) {}
 
     void reset() {
-        phase = 0.0f;
-        secondaryPhase = 0.0f;
+        phase.reset();
+        secondaryPhase.reset();
         outPrimary = 0.0f;
         outSecondary = 0.0f;
     }
 
     AlgorithmOutput process(float pitch, float param1, float param2, float param3) {
+        prepare(pitch, param1, param2, param3);
+        AlgorithmOutput output{};
+        processBlock(&output.primary, &output.secondary, 1);
+        return output;
+    }
+
+    void prepare(float pitch, float param1, float param2, float param3) {
+        if (!inputs.changed(pitch, param1, param2, param3)) {
+            return;
+        }
+
         // Prev tune: drive max 4.5, raw *0.9, clipAmount 0.4, slewCoeff 0.1, limit 0.7.
-        const float drive = expoMap(param1, 0.05f, 2.5f);
-        const float blend = std::clamp(param2, 0.0f, 1.0f);
-        const float edge = 0.5f + std::clamp(param3, 0.0f, 1.0f) * 1.5f;
-
-        phase = stepPhase(phase, pitch, sampleRate);
-        const float sine = std::sin(phase * TWO_PI);
-        const float square = std::tanh(sine * drive);
-
-        secondaryPhase = stepPhase(secondaryPhase, pitch, sampleRate);
-        const float cosine = std::cos(secondaryPhase * TWO_PI);
-        const float saw = square + cosine * (1.0f - square * square) * edge;
-
-        const float raw = square * (1.0f - blend) + saw * blend;
-        // Prev tune: raw *1.2, clipAmount 0.3, slewCoeff 0.12, limit 0.8.
-        const float rawPrimary = std::tanh(raw) * 0.7f;
-        const float rawSecondary = square * 0.7f;
-        const float clipAmount = 0.5f;
-        const float slewCoeff = 0.08f;
-        const float smoothedPrimary = shapeAndSlew(rawPrimary, outPrimary, slewCoeff, clipAmount);
-        const float smoothedSecondary = shapeAndSlew(rawSecondary, outSecondary, slewCoeff, clipAmount);
-        return normalizeOutputLimit(smoothedPrimary, smoothedSecondary, 0.6f);
+        coeffs.drive = expoMap(param1, 0.05f, 2.5f);
+        coeffs.blend = std::clamp(param2, 0.0f, 1.0f);
+        coeffs.edge = 0.5f + std::clamp(param3, 0.0f, 1.0f) * 1.5f;
+        phase.setFrequency(pitch, sampleRate);
+        secondaryPhase.setFrequency(pitch, sampleRate);
+    }
+
+    void processBlock(float* primary, float* secondary, int frames) {
+        const Coefficients c = coeffs;
+        for (int i = 0; i < frames; ++i) {
+            phase.advance();
+            const float sine = phase.sine();
+            const float square = fastTanh(sine * c.drive);
+
+            secondaryPhase.advance();
+            const float cosine = secondaryPhase.cosine();
+            const float saw = square + cosine * (1.0f - square * square) * c.edge;
+
+            const float raw = square * (1.0f - c.blend) + saw * c.blend;
+            // Prev tune: raw *1.2, clipAmount 0.3, slewCoeff 0.12, limit 0.8.
+            const float rawPrimary = fastTanh(raw) * 0.7f;
+            const float rawSecondary = square * 0.7f;
+            const float smoothedPrimary = shapeAndSlew(rawPrimary, outPrimary, kSlewCoeff, kClipAmount);
+            const float smoothedSecondary = shapeAndSlew(rawSecondary, outSecondary, kSlewCoeff, kClipAmount);
+            const AlgorithmOutput result = normalizeOutputLimit(smoothedPrimary, smoothedSecondary, kOutputLimit);
+            primary[i] = result.primary;
+            secondary[i] = result.secondary;
+        }
     }
 
 private:
+    static constexpr float kClipAmount = 0.5f;
+    static constexpr float kSlewCoeff = 0.08f;
+    static constexpr float kOutputLimit = 0.6f;
+
+    struct Coefficients {
+        float drive;
+        float blend;
+        float edge;
+    };
+
     float sampleRate;
-    float phase;
-    float secondaryPhase;
+    ControlInputs inputs;
+    Coefficients coeffs{};
+    PhaseAccumulator phase;
+    PhaseAccumulator secondaryPhase;
     float outPrimary;
     float outSecondary;
 };
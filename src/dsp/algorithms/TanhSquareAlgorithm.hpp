@@ -8,35 +8,84 @@ namespace flues::disyn {
 class TanhSquareAlgorithm {
 public:
     explicit TanhSquareAlgorithm(float sampleRate)
-        : sampleRate(sampleRate), phase(0.0f), outPrimary(0.0f), outSecondary(0.0f) {}
+        : sampleRate(sampleRate), phase(), outPrimary(0.0f), outSecondary(0.0f) {}
 
     void reset() {
-        phase = 0.0f;
+        phase.reset();
         outPrimary = 0.0f;
         outSecondary = 0.0f;
     }
 
     AlgorithmOutput process(float pitch, float param1, float param2, float param3) {
+        prepare(pitch, param1, param2, param3);
+        AlgorithmOutput output{};
+        processBlock(&output.primary, &output.secondary, 1);
+        return output;
+    }
+
+    void prepare(float pitch, float param1, float param2, float param3) {
+        if (!inputs.changed(pitch, param1, param2, param3)) {
+            return;
+        }
+
         // Prev tune: drive max 5.0, trim max 1.2, bias range +/-0.4, raw *1.2.
-        const float drive = expoMap(param1, 0.05f, 2.5f);
-        const float trim = expoMap(param2, 0.3f, 0.9f);
-        const float bias = (std::clamp(param3, 0.0f, 1.0f) - 0.5f) * 0.3f;
+        coeffs.drive = expoMap(param1, 0.05f, 2.5f);
+        coeffs.trim = expoMap(param2, 0.3f, 0.9f);
+        coeffs.bias = (std::clamp(param3, 0.0f, 1.0f) - 0.5f) * 0.3f;
+        phase.setFrequency(pitch, sampleRate);
+    }
+
+    void processBlock(float* primary, float* secondary, int frames) {
+        const Coefficients c = coeffs;
+        for (int i = 0; i < frames; ++i) {
+            phase.advance();
+            const AlgorithmOutput result = kernel(c, phase.raw(), outPrimary, outSecondary);
+            primary[i] = result.primary;
+            secondary[i] = result.secondary;
+        }
+    }
+
+    struct Coefficients {
+        float drive;
+        float trim;
+        float bias;
+    };
 
-        phase = stepPhase(phase, pitch, sampleRate);
-        const float carrier = std::sin(phase * TWO_PI) + bias;
+    const Coefficients& coefficients() const {
+        return coeffs;
+    }
+
+    static AlgorithmOutput kernel(const Coefficients& c, uint32_t phase, float& slewPrimary,
+                                  float& slewSecondary) {
+        const float sine = sineFromPhase(phase);
+        const float carrier = sine + c.bias;
         // Prev tune: raw *1.2, clipAmount 0.4, slewCoeff 0.1, limit 0.8.
-        const float rawPrimary = clampAbs(std::tanh(carrier * drive) * trim, 1.0f) * 0.9f;
-        const float rawSecondary = clampAbs(std::tanh(std::sin(phase * TWO_PI) * drive) * trim, 1.0f) * 0.9f;
-        const float clipAmount = 0.6f;
-        const float slewCoeff = 0.08f;
-        const float smoothedPrimary = shapeAndSlew(rawPrimary, outPrimary, slewCoeff, clipAmount);
-        const float smoothedSecondary = shapeAndSlew(rawSecondary, outSecondary, slewCoeff, clipAmount);
-        return normalizeOutputLimit(smoothedPrimary, smoothedSecondary, 0.6f);
+        const float rawPrimary = clampAbs(fastTanh(carrier * c.drive) * c.trim, 1.0f) * 0.9f;
+        const float rawSecondary = clampAbs(fastTanh(sine * c.drive) * c.trim, 1.0f) * 0.9f;
+        const float smoothedPrimary = shapeAndSlew(rawPrimary, slewPrimary, kSlewCoeff, kClipAmount);
+        const float smoothedSecondary = shapeAndSlew(rawSecondary, slewSecondary, kSlewCoeff, kClipAmount);
+        return normalizeOutputLimit(smoothedPrimary, smoothedSecondary, kOutputLimit);
+    }
+
+    LaneState laneState() const {
+        return {phase.raw(), outPrimary, outSecondary};
+    }
+
+    void setLaneState(const LaneState& state) {
+        phase.setRaw(state.phase);
+        outPrimary = state.slewPrimary;
+        outSecondary = state.slewSecondary;
     }
 
 private:
+    static constexpr float kClipAmount = 0.6f;
+    static constexpr float kSlewCoeff = 0.08f;
+    static constexpr float kOutputLimit = 0.6f;
+
     float sampleRate;
-    float phase;
+    ControlInputs inputs;
+    Coefficients coeffs{};
+    PhaseAccumulator phase;
     float outPrimary;
     float outSecondary;
 };
@@ -1,8 +1,8 @@
 #pragma once
 
+#include <array>
 #include <cmath>
 #include <cstdint>
-#include <vector>
 
 #include "AlgorithmOutput.hpp"
 #include "AlgorithmUtils.hpp"
@@ -19,6 +19,8 @@ public:
           bounceJitter(0.0f),
           frequency(440.0f),
           speed(computeSpeed(440.0f)),
+          edges{},
+          edgeCount(0),
           position({0.0f, 0.0f}),
           velocity({speed, 0.0f}),
           rngState(0x12345678u),
@@ -36,50 +38,71 @@ public:
     }
 
     AlgorithmOutput process(float pitch, float param1, float param2, float param3) {
-        updateParams(pitch, param1, param2, param3);
+        prepare(pitch, param1, param2, param3);
+        AlgorithmOutput output{};
+        processBlock(&output.primary, &output.secondary, 1);
+        return output;
+    }
 
-        if (edges.empty()) {
-            return {0.0f, 0.0f};
+    void prepare(float pitch, float param1, float param2, float param3) {
+        if (!inputs.changed(pitch, param1, param2, param3)) {
+            return;
         }
 
-        Vec2 current = position;
-        Vec2 currentVelocity = velocity;
+        updateParams(pitch, param1, param2, param3);
+    }
 
-        for (int bounce = 0; bounce < 2; ++bounce) {
-            const Vec2 next = {current.x + currentVelocity.x, current.y + currentVelocity.y};
+    void processBlock(float* primary, float* secondary, int frames) {
+        if (edgeCount == 0) {
+            std::fill(primary, primary + frames, 0.0f);
+            std::fill(secondary, secondary + frames, 0.0f);
+            return;
+        }
 
-            if (isInside(next)) {
-                current = next;
-                break;
+        for (int i = 0; i < frames; ++i) {
+            Vec2 current = position;
+            Vec2 currentVelocity = velocity;
+
+            for (int bounce = 0; bounce < 2; ++bounce) {
+                const Vec2 next = {current.x + currentVelocity.x, current.y + currentVelocity.y};
+
+                if (isInside(next)) {
+                    current = next;
+                    break;
+                }
+
+                const PenetrationHit hit = findPenetrationEdge(next);
+                if (!hit.hit) {
+                    current = next;
+                    break;
+                }
+
+                const Vec2 reflected = reflect(currentVelocity, hit.normal);
+                const Vec2 jittered = applyBounceJitter(reflected);
+                const float nudge = 1e-4f;
+                current = {
+                    next.x - hit.normal.x * (hit.distance + nudge),
+                    next.y - hit.normal.y * (hit.distance + nudge)
+                };
+                currentVelocity = jittered;
             }
 
-            const PenetrationHit hit = findPenetrationEdge(next);
-            if (!hit.hit) {
-                current = next;
-                break;
-            }
+            position = current;
+            velocity = currentVelocity;
 
-            const Vec2 reflected = reflect(currentVelocity, hit.normal);
-            const Vec2 jittered = applyBounceJitter(reflected);
-            const float nudge = 1e-4f;
-            current = {
-                next.x - hit.normal.x * (hit.distance + nudge),
-                next.y - hit.normal.y * (hit.distance + nudge)
-            };
-            currentVelocity = jittered;
+            const float smoothedPrimary = shapeAndSlew(position.x, outPrimary, kSlewCoeff, kClipAmount);
+            const float smoothedSecondary = shapeAndSlew(position.y, outSecondary, kSlewCoeff, kClipAmount);
+            const AlgorithmOutput result = normalizeOutput(smoothedPrimary, smoothedSecondary);
+            primary[i] = result.primary;
+            secondary[i] = result.secondary;
         }
-
-        position = current;
-        velocity = currentVelocity;
-
-        const float clipAmount = 1.0f;
-        const float slewCoeff = 0.05f;
-        const float smoothedPrimary = shapeAndSlew(position.x, outPrimary, slewCoeff, clipAmount);
-        const float smoothedSecondary = shapeAndSlew(position.y, outSecondary, slewCoeff, clipAmount);
-        return normalizeOutput(smoothedPrimary, smoothedSecondary);
     }
 
 private:
+    static constexpr float kClipAmount = 1.0f;
+    static constexpr float kSlewCoeff = 0.05f;
+    static constexpr int kMaxSides = 12;
+
     struct Vec2 {
         float x;
         float y;
@@ -102,7 +125,7 @@ private:
     }
 
     void updateParams(float pitch, float param1, float param2, float param3) {
-        const int nextSides = clampInt(3 + static_cast<int>(std::round(param1 * 9.0f)), 3, 12);
+        const int nextSides = clampInt(3 + static_cast<int>(std::round(param1 * 9.0f)), 3, kMaxSides);
         const float nextAngle = degToRad(param2 * 360.0f);
         const float nextJitter = degToRad(param3 * 10.0f);
 
@@ -139,25 +162,22 @@ private:
     }
 
     void rebuildPolygon() {
-        vertices.clear();
-        edges.clear();
-
+        std::array<Vec2, kMaxSides> vertices{};
         const float rotation = static_cast<float>(M_PI) / static_cast<float>(sides);
-        vertices.reserve(static_cast<size_t>(sides));
 
         for (int i = 0; i < sides; ++i) {
             const float theta = (TWO_PI * static_cast<float>(i)) / static_cast<float>(sides) + rotation;
-            vertices.push_back({std::cos(theta), std::sin(theta)});
+            vertices[i] = {std::cos(theta), std::sin(theta)};
         }
 
-        edges.reserve(vertices.size());
-        for (size_t i = 0; i < vertices.size(); ++i) {
+        for (int i = 0; i < sides; ++i) {
             const Vec2 start = vertices[i];
-            const Vec2 end = vertices[(i + 1) % vertices.size()];
+            const Vec2 end = vertices[(i + 1) % sides];
             const Vec2 edge = {end.x - start.x, end.y - start.y};
             const Vec2 normal = normalize({edge.y, -edge.x});
-            edges.push_back({start, end, normal});
+            edges[i] = {start, end, normal};
         }
+        edgeCount = sides;
     }
 
     void resetPosition() {
@@ -183,7 +203,8 @@ private:
 
     RayHit findRayIntersection(const Vec2& direction) const {
         RayHit closest{false, 0.0f, {0.0f, 0.0f}};
-        for (const Edge& edge : edges) {
+        for (int i = 0; i < edgeCount; ++i) {
+            const Edge& edge = edges[i];
             RayHit hit = intersectRaySegment({0.0f, 0.0f}, direction, edge.start, edge.end);
             if (!hit.hit) {
                 continue;
@@ -217,7 +238,8 @@ private:
     PenetrationHit findPenetrationEdge(const Vec2& point) const {
         PenetrationHit worst{false, 0.0f, {0.0f, 0.0f}};
 
-        for (const Edge& edge : edges) {
+        for (int i = 0; i < edgeCount; ++i) {
+            const Edge& edge = edges[i];
             const Vec2 toPoint = {point.x - edge.start.x, point.y - edge.start.y};
             const float distance = toPoint.x * edge.normal.x + toPoint.y * edge.normal.y;
             if (distance > 0.0f && (!worst.hit || distance > worst.distance)) {
@@ -229,7 +251,8 @@ private:
     }
 
     bool isInside(const Vec2& point) const {
-        for (const Edge& edge : edges) {
+        for (int i = 0; i < edgeCount; ++i) {
+            const Edge& edge = edges[i];
             const Vec2 edgeVector = {edge.end.x - edge.start.x, edge.end.y - edge.start.y};
             const Vec2 toPoint = {point.x - edge.start.x, point.y - edge.start.y};
             if (cross(edgeVector, toPoint) < -1e-6f) {
@@ -250,8 +273,9 @@ private:
         }
         const float randValue = randomUnit();
         const float angle = (randValue * 2.0f - 1.0f) * bounceJitter;
-        const float cosAngle = std::cos(angle);
-        const float sinAngle = std::sin(angle);
+        const float anglePhase = angle * INV_TWO_PI;
+        const float cosAngle = cosinePhase(anglePhase);
+        const float sinAngle = sinePhase(anglePhase);
         return {
             vector.x * cosAngle - vector.y * sinAngle,
             vector.x * sinAngle + vector.y * cosAngle
@@ -290,6 +314,7 @@ private:
     }
 
     float sampleRate;
+    ControlInputs inputs;
     int sides;
     float startAngle;
     float startPositionAngle;
@@ -297,8 +322,8 @@ private:
     float frequency;
     float speed;
 
-    std::vector<Vec2> vertices;
-    std::vector<Edge> edges;
+    std::array<Edge, kMaxSides> edges;
+    int edgeCount;
 
     Vec2 position;
     Vec2 velocity;
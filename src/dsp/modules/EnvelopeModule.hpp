@@ -39,27 +39,64 @@ public:
     }
 
     float process() {
-        if (attackNorm <= 0.0f && releaseNorm <= 0.0f) {
-            envelope = 1.0f;
-            isActive = true;
-            return envelope;
+        float value;
+        processBlock(&value, 1);
+        return value;
+    }
+
+    // Per-sample steps for the current settings. hold means attack and release are both zero:
+    // the level sits at full whatever the gate.
+    struct Rates {
+        float attack;
+        float release;
+        bool hold;
+    };
+
+    Rates rates() const {
+        return {1.0f / std::max(attackTime * sampleRate, 1.0f),
+                1.0f / std::max(releaseTime * sampleRate, 1.0f),
+                attackNorm <= 0.0f && releaseNorm <= 0.0f};
+    }
+
+    // Advances a level kept by the caller through one block, so several voices can share one
+    // set of rates. Returns false once a release has reached zero.
+    static bool step(float& level, bool gate, const Rates& rates, float* output, int frames) {
+        if (rates.hold) {
+            level = 1.0f;
+            std::fill(output, output + frames, level);
+            return true;
         }
 
+        bool active = true;
         if (gate) {
-            const float attackRate = 1.0f / std::max(attackTime * sampleRate, 1.0f);
-            envelope += attackRate;
-            if (envelope > 1.0f) {
-                envelope = 1.0f;
+            for (int i = 0; i < frames; ++i) {
+                level += rates.attack;
+                if (level > 1.0f) {
+                    level = 1.0f;
+                }
+                output[i] = level;
             }
         } else {
-            const float releaseRate = 1.0f / std::max(releaseTime * sampleRate, 1.0f);
-            envelope -= releaseRate;
-            if (envelope < 0.0f) {
-                envelope = 0.0f;
-                isActive = false;
+            for (int i = 0; i < frames; ++i) {
+                level -= rates.release;
+                if (level < 0.0f) {
+                    level = 0.0f;
+                    active = false;
+                }
+                output[i] = level;
             }
         }
-        return envelope;
+        return active;
+    }
+
+    // Renders the envelope into output; rates are derived once per block.
+    void processBlock(float* output, int frames) {
+        const Rates blockRates = rates();
+        if (!step(envelope, gate, blockRates, output, frames)) {
+            isActive = false;
+        } else if (blockRates.hold) {
+            isActive = true;
+        }
     }
 
     bool isPlaying() const {
@@ -1,8 +1,16 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
 #include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <variant>
 
 #include "../algorithms/AlgorithmOutput.hpp"
+#include "../algorithms/AlgorithmRegistry.hpp"
 #include "../algorithms/AlgorithmTypes.hpp"
 #include "../algorithms/AlgorithmUtils.hpp"
 #include "../algorithms/Combination1HybridFormantAlgorithm.hpp"
@@ -38,189 +46,450 @@ class OscillatorModule {
 public:
     explicit OscillatorModule(float sampleRate = 44100.0f)
         : sampleRate(sampleRate),
-          fallbackPhase(0.0f),
-          dirichlet(sampleRate),
-          dsfSingle(sampleRate),
-          dsfDouble(sampleRate),
-          tanhSquare(sampleRate),
-          tanhSaw(sampleRate),
-          paf(sampleRate),
-          modfm(sampleRate),
-          combination1(sampleRate),
-          combination2(sampleRate),
-          combination3(sampleRate),
-          combination4(sampleRate),
-          combination5(sampleRate),
-          combination6(sampleRate),
-          combination7(sampleRate),
-          novel1(sampleRate),
-          novel2(sampleRate),
-          novel3(sampleRate),
-          novel4(sampleRate),
-          trajectory(sampleRate),
-          sine(sampleRate),
-          ramp(sampleRate),
-          triangle(sampleRate),
-          pulse(sampleRate),
-          noise(sampleRate),
-          logistic(sampleRate),
-          butterfly(sampleRate) {}
+          fallbackPhase(),
+          slot() {}
 
     void reset() {
-        fallbackPhase = 0.0f;
-        dirichlet.reset();
-        dsfSingle.reset();
-        dsfDouble.reset();
-        tanhSquare.reset();
-        tanhSaw.reset();
-        paf.reset();
-        modfm.reset();
-        combination1.reset();
-        combination2.reset();
-        combination3.reset();
-        combination4.reset();
-        combination5.reset();
-        combination6.reset();
-        combination7.reset();
-        novel1.reset();
-        novel2.reset();
-        novel3.reset();
-        novel4.reset();
-        trajectory.reset();
-        sine.reset();
-        ramp.reset();
-        triangle.reset();
-        pulse.reset();
-        noise.reset();
-        logistic.reset();
-        butterfly.reset();
+        fallbackPhase.reset();
+        resetLanes();
+        runningCopies = 0;
+        std::visit([](auto& algorithm) {
+            if constexpr (!std::is_same_v<std::decay_t<decltype(algorithm)>, std::monostate>) {
+                algorithm.reset();
+            }
+        }, slot);
     }
 
+    // Resets the selected algorithm if it is the one in the slot; any other algorithm is built
+    // fresh when it is next selected, so there is nothing else to reset.
+    void reset(AlgorithmType algorithm) {
+        if (slot.index() == slotIndex(algorithm)) {
+            reset();
+        } else {
+            fallbackPhase.reset();
+            resetLanes();
+        }
+    }
+
+    static constexpr int kMaxUnisonVoices = 8;
+    static constexpr int kLaneGroup = 4; // lanes rendered side by side; counts round up to this
+    static constexpr float kMaxDetuneCents = 50.0f;
+
+    // Unison state, one array per field so that every lane's phase and slew sit side by side.
+    // Lanes from count up to the next multiple of kLaneGroup run with zero gain.
+    struct UnisonLanes {
+        int count = 1;
+        float detune = 0.0f;
+        float spread = 0.0f;
+        float pitch = -1.0f; // pitch the increments were computed for
+        bool active = false; // the lanes, not the algorithm, hold the running phase
+        std::array<float, kMaxUnisonVoices> ratio{};
+        std::array<float, kMaxUnisonVoices> gainLeft{};
+        std::array<float, kMaxUnisonVoices> gainRight{};
+        std::array<uint32_t, kMaxUnisonVoices> phase{};
+        std::array<uint32_t, kMaxUnisonVoices> increment{};
+        std::array<float, kMaxUnisonVoices> slewPrimary{};
+        std::array<float, kMaxUnisonVoices> slewSecondary{};
+    };
+
+    // Unison: voices copies of the selected algorithm, detuned evenly across +/- detune *
+    // kMaxDetuneCents and balanced across spread (0 = centre, 1 = outer copies hard left and
+    // right). One voice is the plain algorithm. Algorithms with a lane kernel (see
+    // hasLaneKernel) render the copies side by side; the others run an instance per copy.
+    void setUnison(int voices, float detune, float spread) {
+        voices = std::clamp(voices, 1, kMaxUnisonVoices);
+        detune = std::clamp(detune, 0.0f, 1.0f);
+        spread = std::clamp(spread, 0.0f, 1.0f);
+        if (voices == lanes.count && detune == lanes.detune && spread == lanes.spread) {
+            return;
+        }
+
+        float sumLeft = 0.0f;
+        float sumRight = 0.0f;
+        lanes.gainLeft.fill(0.0f);
+        lanes.gainRight.fill(0.0f);
+        for (int lane = 0; lane < voices; ++lane) {
+            const float position = voices > 1 ? 2.0f * static_cast<float>(lane) / static_cast<float>(voices - 1) - 1.0f
+                                              : 0.0f;
+            lanes.ratio[lane] = std::exp2(position * detune * kMaxDetuneCents / 1200.0f);
+            // Equal-power balance across the spread.
+            const float angle = (1.0f + position * spread) * (TWO_PI / 8.0f);
+            lanes.gainLeft[lane] = std::cos(angle);
+            lanes.gainRight[lane] = std::sin(angle);
+            sumLeft += lanes.gainLeft[lane];
+            sumRight += lanes.gainRight[lane];
+        }
+        // Each side's gains sum to one, so lanes drifting into phase peak no higher than a
+        // single copy and the measured output gains still hold.
+        for (int lane = 0; lane < voices; ++lane) {
+            lanes.gainLeft[lane] /= sumLeft;
+            lanes.gainRight[lane] /= sumRight;
+        }
+        // The lanes already sounding carry on; added ones start from lane 0's phase.
+        if (lanes.active && voices > lanes.count) {
+            seedLanes(lanes.count);
+        }
+        runningCopies = std::min(runningCopies, voices - 1);
+        lanes.count = voices;
+        lanes.detune = detune;
+        lanes.spread = spread;
+        lanes.pitch = -1.0f;
+    }
+
+    const UnisonLanes& unison() const {
+        return lanes;
+    }
+
+    // Every algorithm in the build profile stacks unison copies; the others render silence.
+    static constexpr bool supportsUnison(AlgorithmType algorithm) {
+        return static_cast<std::size_t>(algorithm) < kAlgorithmTypeCount && isAlgorithmActive(algorithm);
+    }
+
+    // Algorithms that expose a per-sample kernel(coefficients, phase, slew state) and their
+    // LaneState, and so can render unison lanes in one batched loop: those whose state is a
+    // single phase and the output slew, with coefficients that do not depend on pitch.
+    static constexpr bool hasLaneKernel(AlgorithmType algorithm) {
+        const auto index = static_cast<std::size_t>(algorithm);
+        return index < kAlgorithmTypeCount && laneKernels(std::make_index_sequence<kAlgorithmTypeCount>{})[index];
+    }
+
+    // Per-note state for rendering several notes of one algorithm together, one array per
+    // field with a slot per note: the running phase, the phase step for the note's pitch
+    // (phaseFromCycles(pitch / sampleRate)) and the output slew.
+    template <std::size_t Voices>
+    struct VoiceLanes {
+        std::array<uint32_t, Voices> phase{};
+        std::array<uint32_t, Voices> increment{};
+        std::array<float, Voices> slewPrimary{};
+        std::array<float, Voices> slewSecondary{};
+    };
+
+    // Renders every note in voices through the selected algorithm's lane kernel, with the
+    // coefficients prepared once for all of them. Output is interleaved by note, frame i of
+    // note v at [i * Voices + v]. Returns false, rendering nothing, for algorithms without a
+    // lane kernel (see hasLaneKernel); those need an OscillatorModule per note.
+    template <std::size_t Voices>
+    bool processVoices(AlgorithmType algorithm, float param1, float param2, float param3,
+                       VoiceLanes<Voices>& voices, float* primary, float* secondary, int frames);
+
     // param3 defaults for compatibility with older hosts/presets that only provided two params.
     AlgorithmOutput process(AlgorithmType algorithm, float pitch, float param1, float param2, float param3 = 0.5f) {
-        if (!isAlgorithmActive(algorithm)) {
-            return {0.0f, 0.0f};
+        AlgorithmOutput output{};
+        processBlock(algorithm, pitch, param1, param2, param3, &output.primary, &output.secondary, 1);
+        return output;
+    }
+
+    // Renders a block of the selected algorithm through a table of kernels indexed by type;
+    // each entry is renderBlock instantiated for one algorithm so its kernel can be inlined.
+    void processBlock(AlgorithmType algorithm, float pitch, float param1, float param2, float param3,
+                      float* primary, float* secondary, int frames);
+
+private:
+    // Stands in for an algorithm outside the build profile, so it adds no code or storage.
+    template <AlgorithmType Type>
+    struct DisabledAlgorithm {
+        void reset() {}
+    };
+
+    template <AlgorithmType Type, typename Algorithm>
+    using Profiled = std::conditional_t<isAlgorithmActive(Type), Algorithm, DisabledAlgorithm<Type>>;
+
+    // Only the selected algorithm exists. Alternatives follow AlgorithmType order after the
+    // empty state, so the slot index of a type is its enum value plus one.
+    using AlgorithmSlot = std::variant<
+        std::monostate,
+        Profiled<AlgorithmType::DIRICHLET_PULSE, DirichletPulseAlgorithm>,
+        Profiled<AlgorithmType::DSF_SINGLE, DSFSingleAlgorithm>,
+        Profiled<AlgorithmType::DSF_DOUBLE, DSFDoubleAlgorithm>,
+        Profiled<AlgorithmType::TANH_SQUARE, TanhSquareAlgorithm>,
+        Profiled<AlgorithmType::TANH_SAW, TanhSawAlgorithm>,
+        Profiled<AlgorithmType::PAF, PAFAlgorithm>,
+        Profiled<AlgorithmType::MOD_FM, ModFMAlgorithm>,
+        Profiled<AlgorithmType::COMBINATION_1_HYBRID_FORMANT, Combination1HybridFormantAlgorithm>,
+        Profiled<AlgorithmType::COMBINATION_2_CASCADED, Combination2CascadedAlgorithm>,
+        Profiled<AlgorithmType::COMBINATION_3_PARALLEL_BANK, Combination3ParallelBankAlgorithm>,
+        Profiled<AlgorithmType::COMBINATION_4_FEEDBACK, Combination4FeedbackAlgorithm>,
+        Profiled<AlgorithmType::COMBINATION_5_MORPHING, Combination5MorphingAlgorithm>,
+        Profiled<AlgorithmType::COMBINATION_6_INHARMONIC, Combination6InharmonicAlgorithm>,
+        Profiled<AlgorithmType::COMBINATION_7_ADAPTIVE_FILTER, Combination7AdaptiveFilterAlgorithm>,
+        Profiled<AlgorithmType::NOVEL_1_MULTISTAGE, Novel1MultistageAlgorithm>,
+        Profiled<AlgorithmType::NOVEL_2_FREQ_ASYMMETRY, Novel2FreqAsymmetryAlgorithm>,
+        Profiled<AlgorithmType::NOVEL_3_CROSS_MOD, Novel3CrossModAlgorithm>,
+        Profiled<AlgorithmType::NOVEL_4_TAYLOR, Novel4TaylorAlgorithm>,
+        Profiled<AlgorithmType::TRAJECTORY, TrajectoryAlgorithm>,
+        Profiled<AlgorithmType::SINE, SineAlgorithm>,
+        Profiled<AlgorithmType::RAMP, RampAlgorithm>,
+        Profiled<AlgorithmType::TRIANGLE, TriangleAlgorithm>,
+        Profiled<AlgorithmType::PULSE, PulseAlgorithm>,
+        Profiled<AlgorithmType::NOISE, NoiseAlgorithm>,
+        Profiled<AlgorithmType::LOGISTIC, LogisticAlgorithm>,
+        Profiled<AlgorithmType::BUTTERFLY, ButterflyAlgorithm>>;
+
+    static_assert(std::variant_size_v<AlgorithmSlot> == kAlgorithmTypeCount + 1,
+                  "AlgorithmSlot needs one alternative per AlgorithmType");
+
+    static constexpr std::size_t slotIndex(AlgorithmType algorithm) {
+        return static_cast<std::size_t>(algorithm) + 1;
+    }
+
+    template <typename Algorithm, typename = void>
+    struct HasLaneKernel : std::false_type {};
+
+    template <typename Algorithm>
+    struct HasLaneKernel<Algorithm, std::void_t<decltype(&Algorithm::kernel)>> : std::true_type {};
+
+    template <std::size_t... Index>
+    static constexpr std::array<bool, sizeof...(Index)> laneKernels(std::index_sequence<Index...>) {
+        return {{HasLaneKernel<std::variant_alternative_t<Index + 1, AlgorithmSlot>>::value...}};
+    }
+
+    using Kernel = void (OscillatorModule::*)(float, float, float, float, float*, float*, int);
+
+    template <std::size_t... Index>
+    static constexpr std::array<Kernel, sizeof...(Index)> makeKernels(std::index_sequence<Index...>) {
+        return {{&OscillatorModule::renderBlock<static_cast<AlgorithmType>(Index),
+                                                std::variant_alternative_t<Index + 1, AlgorithmSlot>>...}};
+    }
+
+    template <std::size_t Voices>
+    using VoiceKernel = bool (OscillatorModule::*)(float, float, float, VoiceLanes<Voices>&, float*, float*, int);
+
+    template <std::size_t Voices, std::size_t... Index>
+    static constexpr std::array<VoiceKernel<Voices>, sizeof...(Index)> makeVoiceKernels(std::index_sequence<Index...>) {
+        return {{&OscillatorModule::renderVoices<Voices, std::variant_alternative_t<Index + 1, AlgorithmSlot>>...}};
+    }
+
+    // Switching algorithms constructs the new one in place of the old; no algorithm allocates.
+    template <AlgorithmType Type, typename Algorithm>
+    void renderBlock(float pitch, float param1, float param2, float param3,
+                     float* primary, float* secondary, int frames) {
+        if constexpr (isAlgorithmActive(Type)) {
+            Algorithm* algorithm = std::get_if<Algorithm>(&slot);
+            if (algorithm == nullptr) {
+                algorithm = &slot.emplace<Algorithm>(sampleRate);
+                runningCopies = 0;
+            }
+            // Parameters are mapped once per block; the kernel only reads cached coefficients.
+            algorithm->prepare(pitch, param1, param2, param3);
+            if constexpr (HasLaneKernel<Algorithm>::value) {
+                if (lanes.count > 1) {
+                    // Lane 0 carries on from the single copy, so switching unison on does not click.
+                    if (!lanes.active) {
+                        const LaneState state = algorithm->laneState();
+                        lanes.phase[0] = state.phase;
+                        lanes.slewPrimary[0] = state.slewPrimary;
+                        lanes.slewSecondary[0] = state.slewSecondary;
+                        seedLanes(1);
+                        lanes.active = true;
+                    }
+                    renderLanes<Algorithm>(algorithm->coefficients(), pitch, primary, secondary, frames);
+                    return;
+                }
+                // And the single copy carries on from lane 0 when it is switched off.
+                if (lanes.active) {
+                    algorithm->setLaneState({lanes.phase[0], lanes.slewPrimary[0], lanes.slewSecondary[0]});
+                    lanes.active = false;
+                }
+            } else {
+                lanes.active = false;
+                if (lanes.count > 1) {
+                    renderCopies(*algorithm, pitch, param1, param2, param3, primary, secondary, frames);
+                    return;
+                }
+                runningCopies = 0;
+            }
+            algorithm->processBlock(primary, secondary, frames);
+        } else {
+            std::fill(primary, primary + frames, 0.0f);
+            std::fill(secondary, secondary + frames, 0.0f);
+        }
+    }
+
+    // Mixes the unison lanes through the algorithm's kernel with the coefficients it just
+    // prepared. Samples are the outer loop and each group of kLaneGroup lanes the inner one,
+    // with the kernel inlined and branch-free, so the compiler can run a group's lanes in
+    // vector registers; the lane sums are added in lane order afterwards.
+    template <typename Algorithm, typename Coefficients>
+    void renderLanes(const Coefficients& coefficients, float pitch, float* primary, float* secondary, int frames) {
+        if (pitch != lanes.pitch) {
+            for (int lane = 0; lane < kMaxUnisonVoices; ++lane) {
+                lanes.increment[lane] = phaseFromCycles(pitch * lanes.ratio[lane] / sampleRate);
+            }
+            lanes.pitch = pitch;
         }
 
-        switch (algorithm) {
-            case AlgorithmType::DIRICHLET_PULSE:
-                return dirichlet.process(pitch, param1, param2, param3);
-            case AlgorithmType::DSF_SINGLE:
-                return dsfSingle.process(pitch, param1, param2, param3);
-            case AlgorithmType::DSF_DOUBLE:
-                return dsfDouble.process(pitch, param1, param2, param3);
-            case AlgorithmType::TANH_SQUARE:
-                return tanhSquare.process(pitch, param1, param2, param3);
-            case AlgorithmType::TANH_SAW:
-                return tanhSaw.process(pitch, param1, param2, param3);
-            case AlgorithmType::PAF:
-                return paf.process(pitch, param1, param2, param3);
-            case AlgorithmType::MOD_FM:
-                return modfm.process(pitch, param1, param2, param3);
-
-            case AlgorithmType::COMBINATION_1_HYBRID_FORMANT:
-                return combination1.process(pitch, param1, param2, param3);
-            case AlgorithmType::COMBINATION_2_CASCADED:
-                return combination2.process(pitch, param1, param2, param3);
-            case AlgorithmType::COMBINATION_3_PARALLEL_BANK:
-                return combination3.process(pitch, param1, param2, param3);
-            case AlgorithmType::COMBINATION_4_FEEDBACK:
-                return combination4.process(pitch, param1, param2, param3);
-            case AlgorithmType::COMBINATION_5_MORPHING:
-                return combination5.process(pitch, param1, param2, param3);
-            case AlgorithmType::COMBINATION_6_INHARMONIC:
-                return combination6.process(pitch, param1, param2, param3);
-            case AlgorithmType::COMBINATION_7_ADAPTIVE_FILTER:
-                return combination7.process(pitch, param1, param2, param3);
-
-            case AlgorithmType::NOVEL_1_MULTISTAGE:
-                return novel1.process(pitch, param1, param2, param3);
-            case AlgorithmType::NOVEL_2_FREQ_ASYMMETRY:
-                return novel2.process(pitch, param1, param2, param3);
-            case AlgorithmType::NOVEL_3_CROSS_MOD:
-                return novel3.process(pitch, param1, param2, param3);
-            case AlgorithmType::NOVEL_4_TAYLOR:
-                return novel4.process(pitch, param1, param2, param3);
-            case AlgorithmType::TRAJECTORY:
-                return trajectory.process(pitch, param1, param2, param3);
-            case AlgorithmType::SINE:
-                return sine.process(pitch, param1, param2, param3);
-            case AlgorithmType::RAMP:
-                return ramp.process(pitch, param1, param2, param3);
-            case AlgorithmType::TRIANGLE:
-                return triangle.process(pitch, param1, param2, param3);
-            case AlgorithmType::PULSE:
-                return pulse.process(pitch, param1, param2, param3);
-            case AlgorithmType::NOISE:
-                return noise.process(pitch, param1, param2, param3);
-            case AlgorithmType::LOGISTIC:
-                return logistic.process(pitch, param1, param2, param3);
-            case AlgorithmType::BUTTERFLY:
-                return butterfly.process(pitch, param1, param2, param3);
-
-            default:
-                return processSine(pitch);
+        const Coefficients c = coefficients;
+        const int width = (lanes.count + kLaneGroup - 1) / kLaneGroup * kLaneGroup;
+        std::array<uint32_t, kMaxUnisonVoices> phase = lanes.phase;
+        std::array<float, kMaxUnisonVoices> slewPrimary = lanes.slewPrimary;
+        std::array<float, kMaxUnisonVoices> slewSecondary = lanes.slewSecondary;
+        for (int i = 0; i < frames; ++i) {
+            float left = 0.0f;
+            float right = 0.0f;
+            for (int first = 0; first < width; first += kLaneGroup) {
+                float laneLeft[kLaneGroup];
+                float laneRight[kLaneGroup];
+                for (int k = 0; k < kLaneGroup; ++k) {
+                    const int lane = first + k;
+                    phase[lane] += lanes.increment[lane];
+                    const AlgorithmOutput output =
+                        Algorithm::kernel(c, phase[lane], slewPrimary[lane], slewSecondary[lane]);
+                    laneLeft[k] = output.primary * lanes.gainLeft[lane];
+                    laneRight[k] = output.secondary * lanes.gainRight[lane];
+                }
+                for (int k = 0; k < kLaneGroup; ++k) {
+                    left += laneLeft[k];
+                    right += laneRight[k];
+                }
+            }
+            primary[i] = left;
+            secondary[i] = right;
         }
+        lanes.phase = phase;
+        lanes.slewPrimary = slewPrimary;
+        lanes.slewSecondary = slewSecondary;
     }
 
-private:
-    static bool isAlgorithmActive(AlgorithmType algorithm) {
-        // Active set from latest listening pass; disabled ones should remain silent for now.
-        switch (algorithm) {
-            case AlgorithmType::DIRICHLET_PULSE:
-            case AlgorithmType::COMBINATION_1_HYBRID_FORMANT:
-            case AlgorithmType::NOVEL_4_TAYLOR:
-            case AlgorithmType::TRAJECTORY:
-            case AlgorithmType::SINE:
-            case AlgorithmType::RAMP:
-            case AlgorithmType::TRIANGLE:
-            case AlgorithmType::PULSE:
-            case AlgorithmType::NOISE:
-            case AlgorithmType::LOGISTIC:
-            case AlgorithmType::BUTTERFLY:
-                return true;
-            default:
-                return false;
+    // Unison for algorithms without a lane kernel, whose state is more than a phase and a slew:
+    // lane 0 is the algorithm in the slot, so it carries on when unison is switched on or off,
+    // and every other lane runs its own instance, built fresh when the lane is added. Each lane
+    // renders kCopyChunk frames at a time, then the chunk is mixed with samples outer and lanes
+    // inner, in lane order as the kernel lanes are.
+    template <typename Algorithm>
+    void renderCopies(Algorithm& first, float pitch, float param1, float param2, float param3,
+                      float* primary, float* secondary, int frames) {
+        std::array<Algorithm*, kMaxUnisonVoices> algorithms{};
+        algorithms[0] = &first;
+        for (int lane = 1; lane < lanes.count; ++lane) {
+            AlgorithmSlot& copy = copies[lane - 1];
+            Algorithm* algorithm = std::get_if<Algorithm>(&copy);
+            if (algorithm == nullptr || lane > runningCopies) {
+                algorithm = &copy.emplace<Algorithm>(sampleRate);
+            }
+            algorithms[lane] = algorithm;
+        }
+        runningCopies = lanes.count - 1;
+        for (int lane = 0; lane < lanes.count; ++lane) {
+            algorithms[lane]->prepare(pitch * lanes.ratio[lane], param1, param2, param3);
+        }
+
+        float lanePrimary[kMaxUnisonVoices][kCopyChunk];
+        float laneSecondary[kMaxUnisonVoices][kCopyChunk];
+        for (int offset = 0; offset < frames; offset += kCopyChunk) {
+            const int count = std::min(kCopyChunk, frames - offset);
+            for (int lane = 0; lane < lanes.count; ++lane) {
+                algorithms[lane]->processBlock(lanePrimary[lane], laneSecondary[lane], count);
+            }
+            for (int i = 0; i < count; ++i) {
+                float left = 0.0f;
+                float right = 0.0f;
+                for (int lane = 0; lane < lanes.count; ++lane) {
+                    left += lanePrimary[lane][i] * lanes.gainLeft[lane];
+                    right += laneSecondary[lane][i] * lanes.gainRight[lane];
+                }
+                primary[offset + i] = left;
+                secondary[offset + i] = right;
+            }
+        }
+    }
+
+    template <std::size_t Voices, typename Algorithm>
+    bool renderVoices(float param1, float param2, float param3, VoiceLanes<Voices>& voices,
+                      float* primary, float* secondary, int frames) {
+        if constexpr (HasLaneKernel<Algorithm>::value) {
+            Algorithm* algorithm = std::get_if<Algorithm>(&slot);
+            if (algorithm == nullptr) {
+                algorithm = &slot.emplace<Algorithm>(sampleRate);
+            }
+            // Kernel coefficients do not depend on pitch, so the pitch is held fixed and they
+            // are only recomputed when the params change; each note brings its own increment.
+            algorithm->prepare(0.0f, param1, param2, param3);
+            const typename Algorithm::Coefficients c = algorithm->coefficients();
+
+            // Samples outer and notes inner, with the note count known at compile time, so the
+            // compiler can run the notes side by side in vector registers.
+            std::array<uint32_t, Voices> phase = voices.phase;
+            std::array<float, Voices> slewPrimary = voices.slewPrimary;
+            std::array<float, Voices> slewSecondary = voices.slewSecondary;
+            for (int i = 0; i < frames; ++i) {
+                for (std::size_t v = 0; v < Voices; ++v) {
+                    phase[v] += voices.increment[v];
+                    const AlgorithmOutput output = Algorithm::kernel(c, phase[v], slewPrimary[v], slewSecondary[v]);
+                    primary[static_cast<std::size_t>(i) * Voices + v] = output.primary;
+                    secondary[static_cast<std::size_t>(i) * Voices + v] = output.secondary;
+                }
+            }
+            voices.phase = phase;
+            voices.slewPrimary = slewPrimary;
+            voices.slewSecondary = slewSecondary;
+            return true;
+        } else {
+            return false;
+        }
+    }
+
+    // Lanes from first on start at lane 0's phase plus golden-ratio offsets, so that copies
+    // with little detune do not start in step and sum coherently, and with their slew at rest.
+    void seedLanes(int first) {
+        for (int lane = first; lane < kMaxUnisonVoices; ++lane) {
+            lanes.phase[lane] = lanes.phase[0] + static_cast<uint32_t>(lane) * 0x9E3779B9u;
+            lanes.slewPrimary[lane] = 0.0f;
+            lanes.slewSecondary[lane] = 0.0f;
         }
     }
 
-    AlgorithmOutput processSine(float pitch) {
-        fallbackPhase = stepPhase(fallbackPhase, pitch, sampleRate);
-        const float output = std::sin(fallbackPhase * TWO_PI);
+    void resetLanes() {
+        lanes.phase[0] = 0u;
+        lanes.slewPrimary[0] = 0.0f;
+        lanes.slewSecondary[0] = 0.0f;
+        seedLanes(1);
+        lanes.active = false;
+    }
+
+    AlgorithmOutput processSine() {
+        fallbackPhase.advance();
+        const float output = fallbackPhase.sine();
         return {output, output};
     }
 
+    static constexpr int kCopyChunk = 16;
+
     float sampleRate;
-    float fallbackPhase;
-
-    DirichletPulseAlgorithm dirichlet;
-    DSFSingleAlgorithm dsfSingle;
-    DSFDoubleAlgorithm dsfDouble;
-    TanhSquareAlgorithm tanhSquare;
-    TanhSawAlgorithm tanhSaw;
-    PAFAlgorithm paf;
-    ModFMAlgorithm modfm;
-
-    Combination1HybridFormantAlgorithm combination1;
-    Combination2CascadedAlgorithm combination2;
-    Combination3ParallelBankAlgorithm combination3;
-    Combination4FeedbackAlgorithm combination4;
-    Combination5MorphingAlgorithm combination5;
-    Combination6InharmonicAlgorithm combination6;
-    Combination7AdaptiveFilterAlgorithm combination7;
-
-    Novel1MultistageAlgorithm novel1;
-    Novel2FreqAsymmetryAlgorithm novel2;
-    Novel3CrossModAlgorithm novel3;
-    Novel4TaylorAlgorithm novel4;
-    TrajectoryAlgorithm trajectory;
-    SineAlgorithm sine;
-    RampAlgorithm ramp;
-    TriangleAlgorithm triangle;
-    PulseAlgorithm pulse;
-    NoiseAlgorithm noise;
-    LogisticAlgorithm logistic;
-    ButterflyAlgorithm butterfly;
+    PhaseAccumulator fallbackPhase;
+    AlgorithmSlot slot;
+    UnisonLanes lanes;
+    std::array<AlgorithmSlot, kMaxUnisonVoices - 1> copies; // unison lanes 1 and up, without a kernel
+    int runningCopies = 0; // copies holding a running instance of the selected algorithm
 };
 
+// Defined after the class so the kernel table can be built from the complete type.
+inline void OscillatorModule::processBlock(AlgorithmType algorithm, float pitch, float param1, float param2,
+                                           float param3, float* primary, float* secondary, int frames) {
+    static constexpr std::array<Kernel, kAlgorithmTypeCount> kernels =
+        makeKernels(std::make_index_sequence<kAlgorithmTypeCount>{});
+
+    const auto index = static_cast<std::size_t>(algorithm);
+    if (index < kernels.size()) {
+        (this->*kernels[index])(pitch, param1, param2, param3, primary, secondary, frames);
+        return;
+    }
+
+    fallbackPhase.setFrequency(pitch, sampleRate);
+    for (int i = 0; i < frames; ++i) {
+        const AlgorithmOutput output = processSine();
+        primary[i] = output.primary;
+        secondary[i] = output.secondary;
+    }
+}
+
+template <std::size_t Voices>
+bool OscillatorModule::processVoices(AlgorithmType algorithm, float param1, float param2, float param3,
+                                     VoiceLanes<Voices>& voices, float* primary, float* secondary, int frames) {
+    static constexpr std::array<VoiceKernel<Voices>, kAlgorithmTypeCount> kernels =
+        makeVoiceKernels<Voices>(std::make_index_sequence<kAlgorithmTypeCount>{});
+
+    const auto index = static_cast<std::size_t>(algorithm);
+    return index < kernels.size() && (this->*kernels[index])(param1, param2, param3, voices, primary, secondary, frames);
+}
+
 } // namespace flues::disyn
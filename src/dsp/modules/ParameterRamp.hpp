@@ -0,0 +1,58 @@
+#pragma once
+
+namespace flues::disyn {
+
+// Linear ramp from the current value to the latest target, spread across one render call so
+// block-rate control updates do not step (zipper) at block boundaries.
+class ParameterRamp {
+public:
+    explicit ParameterRamp(float initial = 0.0f)
+        : current(initial), targetValue(initial), step(0.0f) {}
+
+    void setTarget(float value) {
+        targetValue = value;
+    }
+
+    // Jumps straight to value, e.g. when a new note starts.
+    void snap(float value) {
+        current = value;
+        targetValue = value;
+        step = 0.0f;
+    }
+
+    // Spreads the remaining distance to the target over the next frames samples.
+    void begin(int frames) {
+        step = frames > 0 ? (targetValue - current) / static_cast<float>(frames) : 0.0f;
+    }
+
+    // Lands exactly on the target at the end of the render call, discarding rounding drift.
+    void finish() {
+        current = targetValue;
+        step = 0.0f;
+    }
+
+    float next() {
+        current += step;
+        return current;
+    }
+
+    float advance(int frames) {
+        current += step * static_cast<float>(frames);
+        return current;
+    }
+
+    float value() const {
+        return current;
+    }
+
+    bool isRamping() const {
+        return step != 0.0f;
+    }
+
+private:
+    float current;
+    float targetValue;
+    float step;
+};
+
+} // namespace flues::disyn
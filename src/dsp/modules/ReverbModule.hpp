@@ -1,39 +1,67 @@
 #pragma once
 
 #include <algorithm>
-#include <vector>
 #include <array>
+#include <cstddef>
+#include <cstdint>
 
 namespace flues::disyn {
 
+namespace detail {
+
+#ifdef DISYN_SAMPLE_RATE
+constexpr float kReverbStorageRate = static_cast<float>(DISYN_SAMPLE_RATE);
+#else
+constexpr float kReverbStorageRate = 48000.0f;
+#endif
+
+constexpr std::size_t kReverbLineCount = 4;
+
+// Mutually non-commensurate lengths; the longest stays under 2048 samples at 48 kHz.
+constexpr std::array<float, kReverbLineCount> kReverbLineSeconds = {
+    0.0297f, 0.0353f, 0.0389f, 0.0421f
+};
+
+constexpr std::size_t nextPowerOfTwo(std::size_t value) {
+    std::size_t result = 1;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+
+constexpr std::size_t reverbRingSize(float storageRate) {
+    float longest = 0.0f;
+    for (const float seconds : kReverbLineSeconds) {
+        longest = seconds > longest ? seconds : longest;
+    }
+    return nextPowerOfTwo(static_cast<std::size_t>(longest * storageRate) + 1);
+}
+
+} // namespace detail
+
+// Stereo feedback delay network: four delay lines mixed through a normalised 4x4 Hadamard
+// matrix. Left feeds lines 0 and 2, right feeds lines 1 and 3, and each output taps its own
+// pair, so one pass gives a decorrelated stereo tail. The lines are interleaved slot by slot in
+// one power-of-two ring sized at compile time, so the wrap is a mask and each sample writes a
+// single group of four adjacent floats.
 class ReverbModule {
 public:
     explicit ReverbModule(float sampleRate = 44100.0f)
         : sampleRate(sampleRate),
           size(0.5f),
           level(0.3f),
-          combDelays{
-              static_cast<std::size_t>(0.0297f * sampleRate),
-              static_cast<std::size_t>(0.0371f * sampleRate),
-              static_cast<std::size_t>(0.0411f * sampleRate),
-              static_cast<std::size_t>(0.0437f * sampleRate)
-          },
-          allpassDelays{
-              static_cast<std::size_t>(0.005f * sampleRate),
-              static_cast<std::size_t>(0.0017f * sampleRate)
-          },
-          combBuffers{
-              std::vector<float>(combDelays[0], 0.0f),
-              std::vector<float>(combDelays[1], 0.0f),
-              std::vector<float>(combDelays[2], 0.0f),
-              std::vector<float>(combDelays[3], 0.0f)
-          },
-          combIndices{0, 0, 0, 0},
-          allpassBuffers{
-              std::vector<float>(allpassDelays[0], 0.0f),
-              std::vector<float>(allpassDelays[1], 0.0f)
-          },
-          allpassIndices{0, 0} {}
+          delays{},
+          position(0u),
+          clearedAt(0u),
+          settling(false),
+          ring{} {
+        for (std::size_t i = 0; i < kLineCount; ++i) {
+            // Rates above kStorageRate are clamped to the ring, which shortens the tail.
+            const uint32_t delay = static_cast<uint32_t>(detail::kReverbLineSeconds[i] * sampleRate);
+            delays[i] = std::clamp<uint32_t>(delay, 1u, kMask);
+        }
+    }
 
     void setSize(float value) {
         size = std::clamp(value, 0.0f, 1.0f);
@@ -43,63 +71,89 @@ public:
         level = std::clamp(value, 0.0f, 1.0f);
     }
 
-    float process(float input) {
-        float combSum = 0.0f;
-        const float feedback = 0.7f + size * 0.28f;
-
-        for (std::size_t i = 0; i < combBuffers.size(); ++i) {
-            auto& buffer = combBuffers[i];
-            const std::size_t index = combIndices[i];
-            const std::size_t delay = combDelays[i];
-
-            const float delayed = buffer[index];
-            buffer[index] = input + delayed * feedback;
-            combSum += delayed;
+    void process(float& left, float& right) {
+        processBlock(&left, &right, 1);
+    }
 
-            combIndices[i] = (index + 1) % delay;
+    // Processes both channels in place; the feedback gain is derived once per block.
+    void processBlock(float* left, float* right, int frames) {
+        if (settling) {
+            render<true>(left, right, frames);
+            settling = position - clearedAt < static_cast<uint32_t>(kRingSlots);
+        } else {
+            render<false>(left, right, frames);
         }
+    }
 
-        float output = combSum / static_cast<float>(combBuffers.size());
-
-        for (std::size_t i = 0; i < allpassBuffers.size(); ++i) {
-            auto& buffer = allpassBuffers[i];
-            const std::size_t index = allpassIndices[i];
-            const std::size_t delay = allpassDelays[i];
+    // Silences the network in O(1): samples written before this call read back as zero until
+    // the write head has travelled past the longest delay, so no buffer is touched.
+    void reset() {
+        clearedAt = position;
+        settling = true;
+    }
 
-            const float delayed = buffer[index];
-            const float g = 0.5f;
-            const float newOutput = -output * g + delayed;
-            buffer[index] = output + delayed * g;
-            output = newOutput;
+    // Ring storage is sized for this rate at compile time.
+    static constexpr float kStorageRate = detail::kReverbStorageRate;
 
-            allpassIndices[i] = (index + 1) % delay;
-        }
+private:
+    static constexpr std::size_t kLineCount = detail::kReverbLineCount;
+    static constexpr std::size_t kRingSlots = detail::reverbRingSize(kStorageRate);
+    static constexpr uint32_t kMask = static_cast<uint32_t>(kRingSlots - 1);
 
-        return input * (1.0f - level) + output * level;
+    float feedbackGain() const {
+        return 0.7f + size * 0.28f;
     }
 
-    void reset() {
-        for (auto& buffer : combBuffers) {
-            std::fill(buffer.begin(), buffer.end(), 0.0f);
-        }
-        for (auto& buffer : allpassBuffers) {
-            std::fill(buffer.begin(), buffer.end(), 0.0f);
+    template <bool Settling>
+    void render(float* left, float* right, int frames) {
+        const float gain = feedbackGain() * 0.5f;
+        const float dry = 1.0f - level;
+        const float wet = level * 0.5f;
+        const std::array<uint32_t, kLineCount> lineDelays = delays;
+        uint32_t writeIndex = position;
+        float* const base = ring.data();
+
+        for (int i = 0; i < frames; ++i, ++writeIndex) {
+            float delayed[kLineCount];
+            for (std::size_t line = 0; line < kLineCount; ++line) {
+                const uint32_t readIndex = writeIndex - lineDelays[line];
+                delayed[line] = base[(readIndex & kMask) * kLineCount + line];
+                if constexpr (Settling) {
+                    if (static_cast<int32_t>(readIndex - clearedAt) < 0) {
+                        delayed[line] = 0.0f;
+                    }
+                }
+            }
+
+            // Fast Walsh-Hadamard transform; gain carries the 1/2 that makes it orthonormal.
+            const float sum01 = delayed[0] + delayed[1];
+            const float diff01 = delayed[0] - delayed[1];
+            const float sum23 = delayed[2] + delayed[3];
+            const float diff23 = delayed[2] - delayed[3];
+
+            const float inLeft = left[i];
+            const float inRight = right[i];
+            float* slot = base + (writeIndex & kMask) * kLineCount;
+            slot[0] = inLeft + (sum01 + sum23) * gain;
+            slot[1] = inRight + (diff01 + diff23) * gain;
+            slot[2] = inLeft + (sum01 - sum23) * gain;
+            slot[3] = inRight + (diff01 - diff23) * gain;
+
+            left[i] = inLeft * dry + (delayed[0] + delayed[2]) * wet;
+            right[i] = inRight * dry + (delayed[1] + delayed[3]) * wet;
         }
-        std::fill(combIndices.begin(), combIndices.end(), 0);
-        std::fill(allpassIndices.begin(), allpassIndices.end(), 0);
+        position = writeIndex;
     }
 
-private:
     float sampleRate;
     float size;
     float level;
 
-    std::array<std::size_t, 4> combDelays;
-    std::array<std::size_t, 2> allpassDelays;
-    std::array<std::vector<float>, 4> combBuffers;
-    std::array<std::size_t, 4> combIndices;
-    std::array<std::vector<float>, 2> allpassBuffers;
-    std::array<std::size_t, 2> allpassIndices;
+    std::array<uint32_t, kLineCount> delays;
+    uint32_t position;
+    uint32_t clearedAt;
+    bool settling;
+    std::array<float, kRingSlots * kLineCount> ring;
 };
 
 } // namespace flues::disyn
@@ -7,19 +7,39 @@ namespace flues::disyn {
 class WavefolderModule {
 public:
     float process(float input, float amount) const {
-        if (!(input > -4.0f && input < 4.0f)) {
-            return 0.0f;
+        if (!(amount >= 0.0f && amount <= 1.0f)) {
+            amount = 0.0f;
         }
+        return fold(input, amount * amount);
+    }
+
+    // Folds a buffer in place; the amount is validated and squared once per block.
+    void processBlock(float* buffer, int frames, float amount) const {
         if (!(amount >= 0.0f && amount <= 1.0f)) {
             amount = 0.0f;
         }
+        const float shaped = amount * amount;
+        for (int i = 0; i < frames; ++i) {
+            buffer[i] = fold(buffer[i], shaped);
+        }
+    }
+
+    // Folds a buffer in place with a per-frame amount, for ramped fold changes.
+    void processBlock(float* buffer, int frames, const float* amounts) const {
+        for (int i = 0; i < frames; ++i) {
+            buffer[i] = process(buffer[i], amounts[i]);
+        }
+    }
+
+private:
+    // amount is the squared fold amount in [0, 1].
+    static float fold(float input, float amount) {
+        if (!(input > -4.0f && input < 4.0f)) {
+            return 0.0f;
+        }
         if (amount <= 0.0f) {
             return input;
         }
-        if (amount > 1.0f) {
-            amount = 1.0f;
-        }
-        amount *= amount;
 
         float x = input * (1.0f + amount * 0.5f);
         if (x < kTableMin) {
@@ -35,7 +55,6 @@ public:
         return mixed * (1.0f - amount * 0.2f);
     }
 
-private:
     static constexpr float kTableMin = -2.0f;
     static constexpr float kTableMax = 2.0f;
     static constexpr float kTableScale = 64.0f;
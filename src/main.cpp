@@ -4,14 +4,18 @@
 #include "dsp/DspTask.h"
 #include "ui/UiTask.h"
 
+#include "Config.h"
 #include "IntercoreQueue.h"
 #include "Parameters.h"
 
 TaskHandle_t uiHandle = nullptr;
 TaskHandle_t dspHandle = nullptr;
+#if DISYN_PIPELINED
+TaskHandle_t dspBackHandle = nullptr;
+#endif
 
-QueueHandle_t disyn::gParamQueue = nullptr;
-QueueHandle_t disyn::gStatusQueue = nullptr;
+disyn::Mailbox<disyn::ParamMessage> disyn::gParamMailbox;
+disyn::Mailbox<disyn::StatusMessage> disyn::gStatusMailbox;
 
 void setup()
 {
@@ -23,14 +27,6 @@ void setup()
     Serial.println(static_cast<int>(esp_reset_reason()));
     Serial.flush();
 
-    disyn::gParamQueue = xQueueCreate(1, sizeof(disyn::ParamMessage));
-    disyn::gStatusQueue = xQueueCreate(1, sizeof(disyn::StatusMessage));
-    Serial.print("BOOT: queues ");
-    Serial.print(disyn::gParamQueue != nullptr ? "ok" : "fail");
-    Serial.print(" / ");
-    Serial.println(disyn::gStatusQueue != nullptr ? "ok" : "fail");
-    Serial.flush();
-
     Serial.println("BOOT: before UI task");
     Serial.flush();
     BaseType_t uiCreated = xTaskCreatePinnedToCore(
@@ -58,6 +54,22 @@ void setup()
     Serial.print("BOOT: DSP task created ");
     Serial.println(dspCreated == pdPASS ? "ok" : "fail");
     Serial.flush();
+
+#if DISYN_PIPELINED
+    // Back half of the DSP chain on core 0. Above the UI so the audio output is never late;
+    // it sleeps in the audio write and while waiting for the front stage.
+    BaseType_t backCreated = xTaskCreatePinnedToCore(
+        disyn::dsp::BackTask,
+        "DisynDSPBack",
+        8192,
+        nullptr,
+        3,
+        &dspBackHandle,
+        0);
+    Serial.print("BOOT: DSP back task created ");
+    Serial.println(backCreated == pdPASS ? "ok" : "fail");
+    Serial.flush();
+#endif
 }
 
 void loop()
@@ -94,7 +94,10 @@ constexpr int kScopeIndex = 10;
 constexpr int kStatusIndex = 11;
 
 constexpr int kScopeSize = disyn::kScopeSize;
-static int scopeTriggerIndex = 0;
+constexpr std::array<const char *, static_cast<size_t>(disyn::ScopeSource::COUNT)> kScopeSourceNames = {
+    "L", "R", "CV0", "CV1", "CV2"};
+// Latest sweep from the DSP core; kept until the next one arrives.
+static disyn::ScopeFrame scopeFrame{};
 
 static float smoothValue(float current, float target, float alpha)
 {
@@ -144,17 +147,7 @@ static void adjustCurrentValue(int delta)
             {
                 int step = (algorithmStepAccum > 0) ? 1 : -1;
                 algorithmStepAccum = 0;
-                int algorithm = static_cast<int>(params.algorithm) + step;
-                int maxAlgorithm = static_cast<int>(disyn::kAlgorithmCount) - 1;
-                if (algorithm < 0)
-                {
-                    algorithm = maxAlgorithm;
-                }
-                if (algorithm > maxAlgorithm)
-                {
-                    algorithm = 0;
-                }
-                params.algorithm = static_cast<uint8_t>(algorithm);
+                params.algorithm = disyn::StepAlgorithm(params.algorithm, step);
             }
         }
         break;
@@ -192,6 +185,10 @@ static void adjustCurrentValue(int delta)
         params.masterGain = clamp(params.masterGain + delta * kDefaultStep, 0.0f, 1.0f);
         break;
     case kScopeIndex:
+        {
+            const int sourceCount = static_cast<int>(disyn::ScopeSource::COUNT);
+            params.scopeSource = static_cast<uint8_t>(((params.scopeSource + delta) % sourceCount + sourceCount) % sourceCount);
+        }
         break;
     case kStatusIndex:
         break;
@@ -266,7 +263,7 @@ static void formatValue(int index, char *buffer, size_t bufferSize)
         dtostrf(params.masterGain, 0, 2, buffer);
         break;
     case kScopeIndex:
-        snprintf(buffer, bufferSize, "-");
+        snprintf(buffer, bufferSize, "%s", kScopeSourceNames[params.scopeSource % kScopeSourceNames.size()]);
         break;
     case kStatusIndex:
         snprintf(buffer, bufferSize, "-");
@@ -439,20 +436,12 @@ static void Tick()
         }
     }
 
-    disyn::ParamMessage message{params};
-    if (disyn::gParamQueue != nullptr)
-    {
-        xQueueOverwrite(disyn::gParamQueue, &message);
-    }
+    // Scope time base: pot2 sets the samples per column, 1 to 1000 on a log scale.
+    const float scopeLogStep = std::pow(10.0f, params.pot2 * 3.0f);
+    params.scopeDecimation = static_cast<uint16_t>(clamp(scopeLogStep + 0.5f, 1.0f, 1000.0f));
 
-    if (disyn::gStatusQueue != nullptr)
-    {
-        disyn::StatusMessage nextStatus{};
-        if (xQueueReceive(disyn::gStatusQueue, &nextStatus, 0) == pdTRUE)
-        {
-            status = nextStatus;
-        }
-    }
+    disyn::gParamMailbox.publish(disyn::ParamMessage{params});
+    disyn::gStatusMailbox.receive(status);
 
     display.clear();
     display.setCursor(0, 0);
@@ -461,58 +450,26 @@ static void Tick()
     {
         const float scopeScale = 0.25f + params.pot0 * 3.75f;
         const float scopeOffset = (params.pot1 - 0.5f) * 1.0f;
-        const float logStep = std::pow(10.0f, params.pot2 * 3.0f);
-        const int scopeStep = clamp(static_cast<int>(logStep + 0.5f), 1, 1024);
-        float bufMin = disyn::gScopeBuffer[0];
-        float bufMax = disyn::gScopeBuffer[0];
-        for (int i = 1; i < kScopeSize; ++i)
-        {
-            bufMin = std::min(bufMin, disyn::gScopeBuffer[i]);
-            bufMax = std::max(bufMax, disyn::gScopeBuffer[i]);
-        }
-        if (bufMax - bufMin < 0.01f)
-        {
-            bufMin = 0.0f;
-            bufMax = 1.0f;
-        }
-
-        const float triggerLevel = (bufMin + bufMax) * 0.5f;
-        const int holdoff = clamp(scopeStep * 4, 1, kScopeSize);
-        int triggerIndex = -1;
-        int sinceTrigger = holdoff;
-        int scopeIndex = static_cast<int>(disyn::gScopeIndex);
-        float prev = disyn::gScopeBuffer[(scopeIndex - 1 + kScopeSize) % kScopeSize];
-        for (int i = 0; i < kScopeSize; ++i)
+        disyn::gScopeMailbox.receive(scopeFrame);
+        // Audio sources are -1..1, control inputs 0..1; map both onto the same 0..1 screen.
+        const bool isAudio = scopeFrame.source == disyn::ScopeSource::OUTPUT_LEFT ||
+                             scopeFrame.source == disyn::ScopeSource::OUTPUT_RIGHT;
+        const float sourceScale = isAudio ? 0.5f : 1.0f;
+        const float sourceOffset = isAudio ? 0.0f : 0.5f;
+        for (int x = 0; x < kScopeSize; ++x)
         {
-            int index = (scopeIndex + i) % kScopeSize;
-            float value = disyn::gScopeBuffer[index];
-            if (sinceTrigger >= holdoff && prev < triggerLevel && value >= triggerLevel)
-            {
-                triggerIndex = index;
-                sinceTrigger = 0;
-            }
-            else
+            const float low = (scopeFrame.minValue[x] - sourceOffset) * sourceScale * scopeScale + 0.5f + scopeOffset;
+            const float high = (scopeFrame.maxValue[x] - sourceOffset) * sourceScale * scopeScale + 0.5f + scopeOffset;
+            const int yLow = 63 - static_cast<int>(clamp(low, 0.0f, 1.0f) * 63.0f);
+            const int yHigh = 63 - static_cast<int>(clamp(high, 0.0f, 1.0f) * 63.0f);
+            for (int y = yHigh; y <= yLow; ++y)
             {
-                ++sinceTrigger;
+                display.drawPixel(x, y, 1);
             }
-            prev = value;
-        }
-        if (triggerIndex >= 0)
-        {
-            scopeTriggerIndex = triggerIndex;
-        }
-        int startIndex = scopeTriggerIndex;
-        for (int x = 0; x < kScopeSize; ++x)
-        {
-            int index = (startIndex + x * scopeStep) % kScopeSize;
-            float value = disyn::gScopeBuffer[index];
-            float normalized = (value - 0.5f) * scopeScale + 0.5f + scopeOffset;
-            int y = 63 - static_cast<int>(clamp(normalized, 0.0f, 1.0f) * 63.0f);
-            y = clamp(y, 0, 63);
-            display.drawPixel(x, y, 1);
         }
         char line[22] = {0};
-        snprintf(line, sizeof(line), "S%.2f O%.2f T%d", scopeScale, scopeOffset, scopeStep);
+        snprintf(line, sizeof(line), "%s S%.1f T%d%s", kScopeSourceNames[params.scopeSource % kScopeSourceNames.size()],
+                 scopeScale, static_cast<int>(params.scopeDecimation), scopeFrame.triggered ? "" : " A");
         display.println(line);
         display.display();
         return;
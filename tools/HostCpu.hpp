@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstdlib>
+#include <fstream>
+#include <string>
+
+// Host clock and ESP32 budget helpers shared by the timing tools. ESP32 figures are estimates:
+// host cycles (ns * host MHz) times a calibration scale for how many LX6 cycles one host cycle
+// costs, against the 240 MHz core clock.
+namespace disyn::tools {
+
+constexpr double kEsp32Hz = 240.0e6;
+
+// First "cpu MHz" entry of /proc/cpuinfo, or 0 when unavailable.
+inline double detectHostMhz() {
+    std::ifstream cpuinfo("/proc/cpuinfo");
+    std::string line;
+    while (std::getline(cpuinfo, line)) {
+        if (line.rfind("cpu MHz", 0) == 0) {
+            const auto colon = line.find(':');
+            if (colon != std::string::npos) {
+                return std::atof(line.c_str() + colon + 1);
+            }
+        }
+    }
+    return 0.0;
+}
+
+inline double esp32Cycles(double hostNs, double hostMhz, double esp32Scale) {
+    return hostNs * hostMhz / 1000.0 * esp32Scale;
+}
+
+} // namespace disyn::tools
@@ -1,91 +1,292 @@
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <sstream>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include "dsp/modules/OscillatorModule.hpp"
+#include "dsp/modules/WavefolderModule.hpp"
+#include "dsp/algorithms/AlgorithmRegistry.hpp"
 #include "dsp/algorithms/AlgorithmTypes.hpp"
 
+// Measures each algorithm over a pitch x param1 x param2 x param3 grid and derives the engine's
+// fold gain (worst peak into the wavefolder hits targetPeak) and output gain (worst RMS after
+// the fold gain the engine applies and the wavefolder hits targetRms). The gains are written
+// unclamped; the registry applies its limits to the product with the voicing trim. Grid points
+// run on a thread pool. --header writes the results as src/dsp/algorithms/AlgorithmGains.hpp,
+// which the registry includes.
+// Build with -DDISYN_ALGOS=DISYN_ALGOS_ALL (the CMake target does) to cover every algorithm.
+
 namespace {
+
+using flues::disyn::AlgorithmType;
+
+constexpr int kBlockFrames = 64;
+constexpr double kTargetPeak = 1.2;
+constexpr double kTargetRms = 0.4;
+constexpr std::array<float, 3> kFoldAmounts = {0.0f, 0.5f, 1.0f};
+
+struct Options {
+    int gridPoints = 9;
+    std::vector<float> pitches = {55.0f, 220.0f, 880.0f};
+    int samples = 4096;
+    float rate = 44100.0f;
+    int jobs = 0;
+    std::string headerPath;
+};
+
+struct Point {
+    AlgorithmType type;
+    float pitch;
+    float p1;
+    float p2;
+    float p3;
+};
+
 struct Stats {
     double peak = 0.0;
     double rms = 0.0;
 };
 
-Stats analyzeAlgorithm(flues::disyn::AlgorithmType type, float pitch,
-                      const std::array<float, 5> &grid, int samples) {
-    flues::disyn::OscillatorModule osc(44100.0f);
-    double worstPeak = 0.0;
-    double worstRms = 0.0;
-
-    for (float p1 : grid) {
-        for (float p2 : grid) {
-            for (float p3 : grid) {
-                osc.reset();
-                double sumSq = 0.0;
-                double peak = 0.0;
-                for (int i = 0; i < samples; ++i) {
-                    const auto out = osc.process(type, pitch, p1, p2, p3);
-                    const double v = std::max(std::abs(out.primary), std::abs(out.secondary));
-                    peak = std::max(peak, v);
-                    sumSq += static_cast<double>(out.primary) * static_cast<double>(out.primary);
+struct Gains {
+    Stats raw;
+    double foldGain = 1.0;
+    double appliedFoldGain = 1.0; // after the voicing trim and the registry's limit
+    double postFoldRms = 0.0;
+    double outputGain = 1.0;
+    double appliedOutputGain = 1.0;
+};
+
+// Renders one grid point; with foldGain > 0 the primary output also goes through the fold
+// gain and wavefolder at each of kFoldAmounts, and the worst post-fold RMS is returned.
+Stats renderPoint(const Options& options, const Point& point, double foldGain) {
+    flues::disyn::OscillatorModule osc(options.rate);
+    flues::disyn::WavefolderModule wavefolder;
+    std::array<float, kBlockFrames> primary{};
+    std::array<float, kBlockFrames> secondary{};
+    std::array<float, kBlockFrames> folded{};
+    std::array<double, kFoldAmounts.size()> foldedSumSq{};
+    double sumSq = 0.0;
+    double peak = 0.0;
+
+    for (int done = 0; done < options.samples; done += kBlockFrames) {
+        const int frames = std::min(kBlockFrames, options.samples - done);
+        osc.processBlock(point.type, point.pitch, point.p1, point.p2, point.p3, primary.data(), secondary.data(),
+                         frames);
+        for (int i = 0; i < frames; ++i) {
+            peak = std::max(peak, static_cast<double>(std::max(std::abs(primary[i]), std::abs(secondary[i]))));
+            sumSq += static_cast<double>(primary[i]) * static_cast<double>(primary[i]);
+        }
+        if (foldGain <= 0.0) {
+            continue;
+        }
+        for (size_t f = 0; f < kFoldAmounts.size(); ++f) {
+            for (int i = 0; i < frames; ++i) {
+                folded[i] = primary[i] * static_cast<float>(foldGain);
+            }
+            wavefolder.processBlock(folded.data(), frames, kFoldAmounts[f]);
+            for (int i = 0; i < frames; ++i) {
+                foldedSumSq[f] += static_cast<double>(folded[i]) * static_cast<double>(folded[i]);
+            }
+        }
+    }
+
+    const double count = static_cast<double>(options.samples);
+    if (foldGain <= 0.0) {
+        return {peak, std::sqrt(sumSq / count)};
+    }
+    const double worstSumSq = *std::max_element(foldedSumSq.begin(), foldedSumSq.end());
+    return {peak, std::sqrt(worstSumSq / count)};
+}
+
+// Runs every point through render on jobs threads; results keep the order of points.
+template <typename Render>
+std::vector<Stats> runParallel(const std::vector<Point>& points, int jobs, Render render) {
+    std::vector<Stats> results(points.size());
+    std::atomic<size_t> next{0};
+    const auto worker = [&]() {
+        for (size_t i = next++; i < points.size(); i = next++) {
+            results[i] = render(points[i]);
+        }
+    };
+    std::vector<std::thread> threads;
+    for (int i = 1; i < jobs; ++i) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    return results;
+}
+
+std::vector<Gains> analyze(const Options& options, int jobs) {
+    std::vector<float> grid(static_cast<size_t>(options.gridPoints));
+    for (int i = 0; i < options.gridPoints; ++i) {
+        grid[static_cast<size_t>(i)] =
+            options.gridPoints > 1 ? static_cast<float>(i) / static_cast<float>(options.gridPoints - 1) : 0.5f;
+    }
+
+    std::vector<Point> points;
+    for (const AlgorithmType type : flues::disyn::kActiveAlgorithms) {
+        for (const float pitch : options.pitches) {
+            for (const float p1 : grid) {
+                for (const float p2 : grid) {
+                    for (const float p3 : grid) {
+                        points.push_back({type, pitch, p1, p2, p3});
+                    }
                 }
-                const double rms = std::sqrt(sumSq / static_cast<double>(samples));
-                worstPeak = std::max(worstPeak, peak);
-                worstRms = std::max(worstRms, rms);
             }
         }
     }
+    const size_t pointsPerAlgorithm = points.size() / flues::disyn::kActiveAlgorithmCount;
+
+    // Pass 1: raw peak and RMS, worst over the grid.
+    std::vector<Gains> gains(flues::disyn::kActiveAlgorithmCount);
+    const std::vector<Stats> raw =
+        runParallel(points, jobs, [&options](const Point& point) { return renderPoint(options, point, 0.0); });
+    for (size_t i = 0; i < raw.size(); ++i) {
+        Stats& worst = gains[i / pointsPerAlgorithm].raw;
+        worst.peak = std::max(worst.peak, raw[i].peak);
+        worst.rms = std::max(worst.rms, raw[i].rms);
+    }
+    for (size_t i = 0; i < gains.size(); ++i) {
+        Gains& entry = gains[i];
+        const double voicing = flues::disyn::algorithmDescriptor(flues::disyn::kActiveAlgorithms[i]).voicing.fold;
+        entry.foldGain = entry.raw.peak > 0.0 ? kTargetPeak / entry.raw.peak : 1.0;
+        entry.appliedFoldGain = std::min(static_cast<double>(flues::disyn::kMaxFoldGain), entry.foldGain * voicing);
+    }
+
+    // Pass 2: RMS after the fold gain the engine applies and the wavefolder, which is what the
+    // output gain scales.
+    const std::vector<Stats> folded = runParallel(points, jobs, [&](const Point& point) {
+        const size_t algorithm = static_cast<size_t>(&point - points.data()) / pointsPerAlgorithm;
+        return renderPoint(options, point, gains[algorithm].appliedFoldGain);
+    });
+    for (size_t i = 0; i < folded.size(); ++i) {
+        Gains& entry = gains[i / pointsPerAlgorithm];
+        entry.postFoldRms = std::max(entry.postFoldRms, folded[i].rms);
+    }
+    for (size_t i = 0; i < gains.size(); ++i) {
+        Gains& entry = gains[i];
+        const double voicing = flues::disyn::algorithmDescriptor(flues::disyn::kActiveAlgorithms[i]).voicing.output;
+        entry.outputGain = entry.postFoldRms > 0.0 ? kTargetRms / entry.postFoldRms : 1.0;
+        entry.appliedOutputGain =
+            std::min(static_cast<double>(flues::disyn::kMaxOutputGain), entry.outputGain * voicing);
+    }
+    return gains;
+}
+
+bool writeHeader(const Options& options, const std::vector<Gains>& gains, const std::string& path) {
+    std::ostringstream pitches;
+    for (size_t i = 0; i < options.pitches.size(); ++i) {
+        pitches << (i > 0 ? "," : "") << options.pitches[i];
+    }
+
+    std::ofstream file(path);
+    file << "#pragma once\n\n"
+         << "// Generated by tools/analyze_gains.cpp --header; do not edit by hand. Measured at "
+         << options.rate << " Hz,\n"
+         << "// pitches " << pitches.str() << " Hz, " << options.gridPoints << " points per param, "
+         << options.samples << " samples per point,\n"
+         << "// target peak " << kTargetPeak << " into the wavefolder and RMS " << kTargetRms << " after it.\n\n"
+         << "#include <array>\n\n"
+         << "#include \"AlgorithmTypes.hpp\"\n\n"
+         << "namespace flues::disyn {\n\n"
+         << "struct AlgorithmGains {\n"
+         << "    float fold;\n"
+         << "    float output;\n"
+         << "};\n\n"
+         << "inline constexpr std::array<AlgorithmGains, kAlgorithmTypeCount> kMeasuredAlgorithmGains = {{\n";
+    file << std::fixed << std::setprecision(4);
+    for (size_t i = 0; i < gains.size(); ++i) {
+        const AlgorithmType type = flues::disyn::kActiveAlgorithms[i];
+        file << "    {" << gains[i].foldGain << "f, " << gains[i].outputGain << "f}, // "
+             << flues::disyn::algorithmDescriptor(type).info.name << "\n";
+    }
+    file << "}};\n\n"
+         << "constexpr const AlgorithmGains& measuredGains(AlgorithmType type) {\n"
+         << "    return kMeasuredAlgorithmGains[static_cast<std::size_t>(type)];\n"
+         << "}\n\n"
+         << "} // namespace flues::disyn\n";
+    return static_cast<bool>(file);
+}
+
+std::vector<float> parseList(const char* text) {
+    std::vector<float> values;
+    std::stringstream stream(text);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        const float value = static_cast<float>(std::atof(item.c_str()));
+        if (value > 0.0f) {
+            values.push_back(value);
+        }
+    }
+    return values;
+}
 
-    return {worstPeak, worstRms};
+bool parseOptions(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (std::strcmp(arg, "--grid") == 0 && hasValue) {
+            options.gridPoints = std::max(1, std::atoi(argv[++i]));
+        } else if (std::strcmp(arg, "--pitches") == 0 && hasValue) {
+            options.pitches = parseList(argv[++i]);
+        } else if (std::strcmp(arg, "--samples") == 0 && hasValue) {
+            options.samples = std::max(kBlockFrames, std::atoi(argv[++i]));
+        } else if (std::strcmp(arg, "--rate") == 0 && hasValue) {
+            options.rate = static_cast<float>(std::atof(argv[++i]));
+        } else if (std::strcmp(arg, "--jobs") == 0 && hasValue) {
+            options.jobs = std::atoi(argv[++i]);
+        } else if (std::strcmp(arg, "--header") == 0 && hasValue) {
+            options.headerPath = argv[++i];
+        } else {
+            return false;
+        }
+    }
+    return !options.pitches.empty() && options.rate > 0.0f;
 }
 }
 
-int main() {
-    const std::array<float, 5> grid = {0.0f, 0.25f, 0.5f, 0.75f, 1.0f};
-    const float pitch = 220.0f;
-    const int samples = 4096;
-    const double targetPeak = 1.2;
-    const double targetRms = 0.4;
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        std::cerr << "usage: " << argv[0]
+                  << " [--grid points] [--pitches 55,220,880] [--samples n] [--rate hz] [--jobs n]"
+                     " [--header src/dsp/algorithms/AlgorithmGains.hpp]" << std::endl;
+        return 2;
+    }
+    if (!options.headerPath.empty() && flues::disyn::kActiveAlgorithmCount != flues::disyn::kAlgorithmTypeCount) {
+        std::cerr << "--header needs every algorithm; build with -DDISYN_ALGOS=DISYN_ALGOS_ALL" << std::endl;
+        return 2;
+    }
 
-    struct AlgoEntry {
-        flues::disyn::AlgorithmType type;
-        const char *name;
-    };
+    const int jobs = options.jobs > 0 ? options.jobs : static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    const std::vector<Gains> gains = analyze(options, jobs);
 
-    const std::array<AlgoEntry, 19> algos = {{
-        {flues::disyn::AlgorithmType::DIRICHLET_PULSE, "Dirichlet"},
-        {flues::disyn::AlgorithmType::DSF_SINGLE, "DSF Single"},
-        {flues::disyn::AlgorithmType::DSF_DOUBLE, "DSF Double"},
-        {flues::disyn::AlgorithmType::TANH_SQUARE, "Tanh Square"},
-        {flues::disyn::AlgorithmType::TANH_SAW, "Tanh Saw"},
-        {flues::disyn::AlgorithmType::PAF, "PAF"},
-        {flues::disyn::AlgorithmType::MOD_FM, "Mod FM"},
-        {flues::disyn::AlgorithmType::COMBINATION_1_HYBRID_FORMANT, "Formant"},
-        {flues::disyn::AlgorithmType::COMBINATION_2_CASCADED, "Cascade"},
-        {flues::disyn::AlgorithmType::COMBINATION_3_PARALLEL_BANK, "Banks"},
-        {flues::disyn::AlgorithmType::COMBINATION_4_FEEDBACK, "Feedback"},
-        {flues::disyn::AlgorithmType::COMBINATION_5_MORPHING, "Morphing"},
-        {flues::disyn::AlgorithmType::COMBINATION_6_INHARMONIC, "Inharmonic"},
-        {flues::disyn::AlgorithmType::COMBINATION_7_ADAPTIVE_FILTER, "AFilter"},
-        {flues::disyn::AlgorithmType::NOVEL_1_MULTISTAGE, "Multi"},
-        {flues::disyn::AlgorithmType::NOVEL_2_FREQ_ASYMMETRY, "Asym"},
-        {flues::disyn::AlgorithmType::NOVEL_3_CROSS_MOD, "Cross"},
-        {flues::disyn::AlgorithmType::NOVEL_4_TAYLOR, "Taylor"},
-        {flues::disyn::AlgorithmType::TRAJECTORY, "Trajectory"},
-    }};
-
-    std::cout << "algorithm,peak,rms,fold_gain,out_gain" << std::endl;
-    for (const auto &algo : algos) {
-        const Stats stats = analyzeAlgorithm(algo.type, pitch, grid, samples);
-        const double foldGain = stats.peak > 0.0 ? std::min(1.0, targetPeak / stats.peak) : 1.0;
-        const double outGain = stats.rms > 0.0 ? std::min(2.0, targetRms / (stats.rms * foldGain)) : 1.0;
-        std::cout << algo.name << ","
-                  << std::fixed << std::setprecision(4)
-                  << stats.peak << "," << stats.rms << "," << foldGain << "," << outGain << std::endl;
+    std::cout << "algorithm,peak,rms,fold_gain,applied_fold_gain,post_fold_rms,out_gain,applied_out_gain"
+              << std::endl;
+    std::cout << std::fixed << std::setprecision(4);
+    for (size_t i = 0; i < gains.size(); ++i) {
+        const Gains& entry = gains[i];
+        std::cout << flues::disyn::algorithmDescriptor(flues::disyn::kActiveAlgorithms[i]).info.name << ","
+                  << entry.raw.peak << "," << entry.raw.rms << "," << entry.foldGain << "," << entry.appliedFoldGain
+                  << "," << entry.postFoldRms << "," << entry.outputGain << "," << entry.appliedOutputGain
+                  << std::endl;
     }
 
+    if (!options.headerPath.empty() && !writeHeader(options, gains, options.headerPath)) {
+        std::cerr << "cannot write " << options.headerPath << std::endl;
+        return 1;
+    }
     return 0;
 }
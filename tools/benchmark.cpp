@@ -0,0 +1,310 @@
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "dsp/DisynEngine.hpp"
+#include "dsp/VoicePool.hpp"
+#include "dsp/algorithms/AlgorithmRegistry.hpp"
+#include "dsp/modules/OscillatorModule.hpp"
+
+#include "HostCpu.hpp"
+
+// Times every algorithm in this build through OscillatorModule, through the full
+// DisynEngine chain, as a four-note chord through VoicePool<4> and as eight unison copies
+// through OscillatorModule. Build with -DDISYN_ALGOS=DISYN_ALGOS_ALL (the CMake target
+// does) to cover algorithms outside the firmware profile.
+// ESP32 columns are estimates from HostCpu.hpp: --host-mhz defaults to /proc/cpuinfo and
+// --esp32-scale to 1 until calibrated against hardware.
+
+namespace {
+
+using flues::disyn::AlgorithmType;
+
+constexpr int kBlockFrames = 64;
+constexpr std::array<float, 3> kGrid = {0.0f, 0.5f, 1.0f};
+constexpr std::array<float, 3> kPitches = {55.0f, 440.0f, 3520.0f};
+
+struct Options {
+    std::vector<int> rates = {44100, 48000, 96000};
+    std::string jsonPath;
+    std::string baselinePath;
+    std::string filter;
+    double tolerancePercent = 10.0;
+    double hostMhz = 0.0;
+    double esp32Scale = 1.0;
+    int repeats = 3;
+    int blocksPerPoint = 32;
+};
+
+struct Result {
+    std::string name;
+    int rate;
+    double nsPerSample;
+};
+
+volatile float sink = 0.0f;
+
+// Fastest of repeats runs; each run covers the whole pitch/param grid.
+template <typename Run>
+double bestNsPerSample(const Options& options, Run run) {
+    double best = 0.0;
+    for (int r = 0; r < options.repeats; ++r) {
+        const auto start = std::chrono::steady_clock::now();
+        const long samples = run();
+        const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+        const double ns = elapsed.count() / static_cast<double>(samples);
+        best = r == 0 ? ns : std::min(best, ns);
+    }
+    return best;
+}
+
+double benchmarkOscillator(const Options& options, AlgorithmType type, int rate, int unisonVoices = 1) {
+    std::array<float, kBlockFrames> primary{};
+    std::array<float, kBlockFrames> secondary{};
+    return bestNsPerSample(options, [&]() {
+        long samples = 0;
+        for (const float pitch : kPitches) {
+            for (const float p1 : kGrid) {
+                for (const float p2 : kGrid) {
+                    for (const float p3 : kGrid) {
+                        flues::disyn::OscillatorModule oscillator(static_cast<float>(rate));
+                        oscillator.setUnison(unisonVoices, 0.5f, 1.0f);
+                        for (int block = 0; block < options.blocksPerPoint; ++block) {
+                            oscillator.processBlock(type, pitch, p1, p2, p3, primary.data(), secondary.data(),
+                                                    kBlockFrames);
+                            sink = sink + primary[0] + secondary[kBlockFrames - 1];
+                        }
+                        samples += static_cast<long>(options.blocksPerPoint) * kBlockFrames;
+                    }
+                }
+            }
+        }
+        return samples;
+    });
+}
+
+double benchmarkEngine(const Options& options, AlgorithmType type, int rate) {
+    std::array<float, kBlockFrames> left{};
+    std::array<float, kBlockFrames> right{};
+    return bestNsPerSample(options, [&]() {
+        long samples = 0;
+        for (const float pitch : kPitches) {
+            for (const float p1 : kGrid) {
+                for (const float p2 : kGrid) {
+                    flues::disyn::DisynEngine engine(static_cast<float>(rate));
+                    engine.setAlgorithm(static_cast<int>(type));
+                    engine.setParam1(p1);
+                    engine.setParam2(p2);
+                    engine.setWavefoldAmount(0.5f);
+                    engine.setReverbLevel(0.3f);
+                    engine.noteOn(pitch, 1.0f);
+                    for (int block = 0; block < options.blocksPerPoint; ++block) {
+                        engine.processBlock(left.data(), right.data(), kBlockFrames);
+                        sink = sink + left[0] + right[kBlockFrames - 1];
+                    }
+                    samples += static_cast<long>(options.blocksPerPoint) * kBlockFrames;
+                }
+            }
+        }
+        return samples;
+    });
+}
+
+// A major chord with the octave, so all four voices sound for the whole run.
+double benchmarkPool(const Options& options, AlgorithmType type, int rate) {
+    constexpr std::array<float, 4> kChord = {1.0f, 1.25f, 1.5f, 2.0f};
+    std::array<float, kBlockFrames> left{};
+    std::array<float, kBlockFrames> right{};
+    return bestNsPerSample(options, [&]() {
+        long samples = 0;
+        for (const float pitch : kPitches) {
+            for (const float p1 : kGrid) {
+                for (const float p2 : kGrid) {
+                    flues::disyn::VoicePool<kChord.size()> pool(static_cast<float>(rate));
+                    pool.setAlgorithm(static_cast<int>(type));
+                    pool.setParam1(p1);
+                    pool.setParam2(p2);
+                    pool.setWavefoldAmount(0.5f);
+                    pool.setReverbLevel(0.3f);
+                    for (size_t note = 0; note < kChord.size(); ++note) {
+                        pool.noteOn(static_cast<int>(note), pitch * kChord[note], 1.0f);
+                    }
+                    for (int block = 0; block < options.blocksPerPoint; ++block) {
+                        pool.processBlock(left.data(), right.data(), kBlockFrames);
+                        sink = sink + left[0] + right[kBlockFrames - 1];
+                    }
+                    samples += static_cast<long>(options.blocksPerPoint) * kBlockFrames;
+                }
+            }
+        }
+        return samples;
+    });
+}
+
+double cyclesPerSample(const Options& options, double nsPerSample) {
+    return disyn::tools::esp32Cycles(nsPerSample, options.hostMhz, options.esp32Scale);
+}
+
+double blockPercent(const Options& options, double nsPerSample, int rate) {
+    return 100.0 * cyclesPerSample(options, nsPerSample) * rate / disyn::tools::kEsp32Hz;
+}
+
+// Reads the one-result-per-line layout written by writeJson.
+std::vector<Result> readBaseline(const std::string& path) {
+    std::vector<Result> results;
+    std::ifstream file(path);
+    std::string line;
+    while (std::getline(file, line)) {
+        const auto nameAt = line.find("\"name\": \"");
+        const auto rateAt = line.find("\"rate\": ");
+        const auto nsAt = line.find("\"ns_per_sample\": ");
+        if (nameAt == std::string::npos || rateAt == std::string::npos || nsAt == std::string::npos) {
+            continue;
+        }
+        const auto nameStart = nameAt + 9;
+        const auto nameEnd = line.find('"', nameStart);
+        results.push_back({line.substr(nameStart, nameEnd - nameStart), std::atoi(line.c_str() + rateAt + 8),
+                           std::atof(line.c_str() + nsAt + 17)});
+    }
+    return results;
+}
+
+void writeJson(const Options& options, const std::vector<Result>& results, const std::string& path) {
+    std::ofstream file(path);
+    file << std::fixed << std::setprecision(3);
+    file << "{\n  \"host_mhz\": " << options.hostMhz << ",\n  \"esp32_scale\": " << options.esp32Scale
+         << ",\n  \"block_frames\": " << kBlockFrames << ",\n  \"results\": [\n";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const Result& result = results[i];
+        file << "    {\"name\": \"" << result.name << "\", \"rate\": " << result.rate
+             << ", \"ns_per_sample\": " << result.nsPerSample
+             << ", \"cycles_per_sample\": " << cyclesPerSample(options, result.nsPerSample)
+             << ", \"esp32_block_percent\": " << blockPercent(options, result.nsPerSample, result.rate) << "}"
+             << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    file << "  ]\n}\n";
+}
+
+// Prints the change against the baseline; returns the number of results slower than tolerance.
+int compareBaseline(const Options& options, const std::vector<Result>& results) {
+    const std::vector<Result> baseline = readBaseline(options.baselinePath);
+    if (baseline.empty()) {
+        std::cerr << "no results in baseline " << options.baselinePath << std::endl;
+        return 1;
+    }
+
+    int regressions = 0;
+    std::cout << "\nname,rate,baseline_ns,ns,change_percent" << std::endl;
+    for (const Result& result : results) {
+        const auto match = std::find_if(baseline.begin(), baseline.end(), [&result](const Result& entry) {
+            return entry.name == result.name && entry.rate == result.rate;
+        });
+        if (match == baseline.end() || match->nsPerSample <= 0.0) {
+            continue;
+        }
+        const double change = 100.0 * (result.nsPerSample - match->nsPerSample) / match->nsPerSample;
+        const bool regressed = change > options.tolerancePercent;
+        regressions += regressed ? 1 : 0;
+        std::cout << result.name << "," << result.rate << "," << match->nsPerSample << "," << result.nsPerSample
+                  << "," << std::showpos << change << std::noshowpos << (regressed ? ",REGRESSION" : "")
+                  << std::endl;
+    }
+    return regressions;
+}
+
+std::vector<int> parseRates(const char* text) {
+    std::vector<int> rates;
+    std::stringstream stream(text);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        const int rate = std::atoi(item.c_str());
+        if (rate > 0) {
+            rates.push_back(rate);
+        }
+    }
+    return rates;
+}
+
+bool parseOptions(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (std::strcmp(arg, "--rates") == 0 && hasValue) {
+            options.rates = parseRates(argv[++i]);
+        } else if (std::strcmp(arg, "--json") == 0 && hasValue) {
+            options.jsonPath = argv[++i];
+        } else if (std::strcmp(arg, "--baseline") == 0 && hasValue) {
+            options.baselinePath = argv[++i];
+        } else if (std::strcmp(arg, "--tolerance") == 0 && hasValue) {
+            options.tolerancePercent = std::atof(argv[++i]);
+        } else if (std::strcmp(arg, "--filter") == 0 && hasValue) {
+            options.filter = argv[++i];
+        } else if (std::strcmp(arg, "--host-mhz") == 0 && hasValue) {
+            options.hostMhz = std::atof(argv[++i]);
+        } else if (std::strcmp(arg, "--esp32-scale") == 0 && hasValue) {
+            options.esp32Scale = std::atof(argv[++i]);
+        } else if (std::strcmp(arg, "--repeats") == 0 && hasValue) {
+            options.repeats = std::max(1, std::atoi(argv[++i]));
+        } else if (std::strcmp(arg, "--blocks") == 0 && hasValue) {
+            options.blocksPerPoint = std::max(1, std::atoi(argv[++i]));
+        } else {
+            return false;
+        }
+    }
+    return !options.rates.empty();
+}
+}
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        std::cerr << "usage: " << argv[0]
+                  << " [--rates 44100,48000,96000] [--filter text] [--json out.json]"
+                     " [--baseline base.json] [--tolerance percent] [--host-mhz mhz]"
+                     " [--esp32-scale factor] [--repeats n] [--blocks n]" << std::endl;
+        return 2;
+    }
+    if (options.hostMhz <= 0.0) {
+        options.hostMhz = disyn::tools::detectHostMhz();
+    }
+
+    std::vector<Result> results;
+    std::cout << "name,rate,ns_per_sample,cycles_per_sample,esp32_block_percent" << std::endl;
+    std::cout << std::fixed << std::setprecision(3);
+    for (const int rate : options.rates) {
+        for (const AlgorithmType type : flues::disyn::kActiveAlgorithms) {
+            const std::string algorithm = flues::disyn::algorithmDescriptor(type).info.name;
+            for (const char* stage : {"osc", "engine", "pool4", "unison8"}) {
+                const std::string name = std::string(stage) + "/" + algorithm;
+                if (!options.filter.empty() && name.find(options.filter) == std::string::npos) {
+                    continue;
+                }
+                const bool unison = std::strcmp(stage, "unison8") == 0;
+                const double ns = std::strcmp(stage, "osc") == 0      ? benchmarkOscillator(options, type, rate)
+                                  : std::strcmp(stage, "engine") == 0 ? benchmarkEngine(options, type, rate)
+                                  : unison                            ? benchmarkOscillator(options, type, rate, 8)
+                                                                      : benchmarkPool(options, type, rate);
+                results.push_back({name, rate, ns});
+                std::cout << name << "," << rate << "," << ns << "," << cyclesPerSample(options, ns) << ","
+                          << blockPercent(options, ns, rate) << std::endl;
+            }
+        }
+    }
+
+    if (!options.jsonPath.empty()) {
+        writeJson(options, results, options.jsonPath);
+    }
+    if (!options.baselinePath.empty()) {
+        return compareBaseline(options, results) > 0 ? 1 : 0;
+    }
+    return 0;
+}
@@ -0,0 +1,301 @@
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "dsp/algorithms/AlgorithmRegistry.hpp"
+#include "dsp/modules/OscillatorModule.hpp"
+
+// Checks that the fast math kernels (sine table, Pade tanh) do not change the sound. This file
+// builds twice: disyn_math_check with DISYN_MATH_FAST and disyn_math_check_reference with
+// DISYN_MATH_REFERENCE. The reference binary only renders (--dump); the fast one runs it, renders
+// the same grid itself, and reports per algorithm the max sample error, the spectral difference
+// (averaged magnitude spectra, worst grid point) and the speedup of the render. It exits
+// non-zero when an algorithm's spectral difference is above --max-spectral-db.
+// Trajectory's jittered bounces are chaotic: any change in rounding sends the ball down another
+// path, so it is listed as CHAOTIC rather than failing the check.
+
+namespace {
+
+using flues::disyn::AlgorithmType;
+
+constexpr int kBlockFrames = 64;
+constexpr std::array<float, 3> kGrid = {0.0f, 0.5f, 1.0f};
+constexpr std::array<float, 3> kPitches = {55.0f, 440.0f, 3520.0f};
+constexpr std::size_t kPointCount = kPitches.size() * kGrid.size() * kGrid.size() * kGrid.size();
+constexpr std::size_t kSegment = 1024;
+
+bool isChaotic(AlgorithmType type) {
+    return type == AlgorithmType::TRAJECTORY;
+}
+
+struct Options {
+    int rate = 44100;
+    int samples = 8192; // per grid point, rounded up to a power of two for the FFT
+    int repeats = 3;
+    double maxSpectralDb = -40.0;
+    std::string dumpPath;
+    std::string referencePath;
+    std::string filter;
+};
+
+// One algorithm's render over the whole grid: primary then secondary per point.
+struct Render {
+    double ns = 0.0;
+    std::vector<float> samples;
+};
+
+Render renderAlgorithm(const Options& options, AlgorithmType type) {
+    const std::size_t perPoint = static_cast<std::size_t>(options.samples);
+    Render render;
+    render.samples.resize(kPointCount * perPoint * 2);
+    std::array<float, kBlockFrames> primary{};
+    std::array<float, kBlockFrames> secondary{};
+
+    for (int r = 0; r < options.repeats; ++r) {
+        const auto start = std::chrono::steady_clock::now();
+        std::size_t point = 0;
+        for (const float pitch : kPitches) {
+            for (const float p1 : kGrid) {
+                for (const float p2 : kGrid) {
+                    for (const float p3 : kGrid) {
+                        flues::disyn::OscillatorModule oscillator(static_cast<float>(options.rate));
+                        float* out = render.samples.data() + point * perPoint * 2;
+                        for (std::size_t done = 0; done < perPoint; done += kBlockFrames) {
+                            const int frames = static_cast<int>(std::min<std::size_t>(kBlockFrames, perPoint - done));
+                            oscillator.processBlock(type, pitch, p1, p2, p3, primary.data(), secondary.data(),
+                                                    frames);
+                            std::copy(primary.begin(), primary.begin() + frames, out + done);
+                            std::copy(secondary.begin(), secondary.begin() + frames, out + perPoint + done);
+                        }
+                        ++point;
+                    }
+                }
+            }
+        }
+        const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+        render.ns = r == 0 ? elapsed.count() : std::min(render.ns, elapsed.count());
+    }
+    return render;
+}
+
+bool writeDump(const Options& options, const std::string& path) {
+    std::ofstream file(path, std::ios::binary);
+    for (const AlgorithmType type : flues::disyn::kActiveAlgorithms) {
+        const Render render = renderAlgorithm(options, type);
+        const uint64_t count = render.samples.size();
+        file.write(reinterpret_cast<const char*>(&render.ns), sizeof render.ns);
+        file.write(reinterpret_cast<const char*>(&count), sizeof count);
+        file.write(reinterpret_cast<const char*>(render.samples.data()),
+                   static_cast<std::streamsize>(count * sizeof(float)));
+    }
+    return static_cast<bool>(file);
+}
+
+std::vector<Render> readDump(const std::string& path) {
+    std::vector<Render> renders;
+    std::ifstream file(path, std::ios::binary);
+    Render render;
+    uint64_t count = 0;
+    while (file.read(reinterpret_cast<char*>(&render.ns), sizeof render.ns) &&
+           file.read(reinterpret_cast<char*>(&count), sizeof count)) {
+        render.samples.resize(count);
+        if (!file.read(reinterpret_cast<char*>(render.samples.data()),
+                       static_cast<std::streamsize>(count * sizeof(float)))) {
+            break;
+        }
+        renders.push_back(render);
+    }
+    return renders;
+}
+
+// In-place iterative radix-2 FFT; data.size() must be a power of two.
+void fft(std::vector<std::complex<double>>& data) {
+    const std::size_t n = data.size();
+    for (std::size_t i = 1, j = 0; i < n; ++i) {
+        std::size_t bit = n >> 1;
+        for (; j & bit; bit >>= 1) {
+            j ^= bit;
+        }
+        j ^= bit;
+        if (i < j) {
+            std::swap(data[i], data[j]);
+        }
+    }
+    for (std::size_t length = 2; length <= n; length <<= 1) {
+        const std::complex<double> step = std::polar(1.0, -2.0 * M_PI / static_cast<double>(length));
+        for (std::size_t i = 0; i < n; i += length) {
+            std::complex<double> w(1.0, 0.0);
+            for (std::size_t k = 0; k < length / 2; ++k) {
+                const std::complex<double> even = data[i + k];
+                const std::complex<double> odd = data[i + k + length / 2] * w;
+                data[i + k] = even + odd;
+                data[i + k + length / 2] = even - odd;
+                w *= step;
+            }
+        }
+    }
+}
+
+// Welch estimate: Hann-windowed kSegment-sample FFTs with 50% overlap, power averaged. Averaging
+// compares the spectrum a listener hears rather than sample alignment, which matters for the
+// algorithms whose trajectories are chaotic.
+std::vector<double> averagedSpectrum(const float* samples, std::size_t count) {
+    const std::size_t segment = std::min(kSegment, count);
+    std::vector<double> power(segment / 2 + 1, 0.0);
+    std::vector<std::complex<double>> data(segment);
+    for (std::size_t start = 0; start + segment <= count; start += segment / 2) {
+        for (std::size_t i = 0; i < segment; ++i) {
+            const double window =
+                0.5 - 0.5 * std::cos(2.0 * M_PI * static_cast<double>(i) / static_cast<double>(segment));
+            data[i] = static_cast<double>(samples[start + i]) * window;
+        }
+        fft(data);
+        for (std::size_t i = 0; i < power.size(); ++i) {
+            power[i] += std::norm(data[i]);
+        }
+    }
+    for (double& bin : power) {
+        bin = std::sqrt(bin);
+    }
+    return power;
+}
+
+// Energy of the magnitude-spectrum difference relative to the reference, in dB.
+double spectralDifferenceDb(const float* reference, const float* fast, std::size_t count) {
+    const std::vector<double> a = averagedSpectrum(reference, count);
+    const std::vector<double> b = averagedSpectrum(fast, count);
+    double signal = 0.0;
+    double difference = 0.0;
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        signal += a[i] * a[i];
+        difference += (a[i] - b[i]) * (a[i] - b[i]);
+    }
+    if (signal <= 1e-12) {
+        return difference <= 1e-12 ? -200.0 : 0.0;
+    }
+    return std::max(-200.0, 10.0 * std::log10(difference / signal));
+}
+
+bool parseOptions(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (std::strcmp(arg, "--rate") == 0 && hasValue) {
+            options.rate = std::atoi(argv[++i]);
+        } else if (std::strcmp(arg, "--samples") == 0 && hasValue) {
+            options.samples = std::max(kBlockFrames, std::atoi(argv[++i]));
+        } else if (std::strcmp(arg, "--repeats") == 0 && hasValue) {
+            options.repeats = std::max(1, std::atoi(argv[++i]));
+        } else if (std::strcmp(arg, "--max-spectral-db") == 0 && hasValue) {
+            options.maxSpectralDb = std::atof(argv[++i]);
+        } else if (std::strcmp(arg, "--dump") == 0 && hasValue) {
+            options.dumpPath = argv[++i];
+        } else if (std::strcmp(arg, "--reference") == 0 && hasValue) {
+            options.referencePath = argv[++i];
+        } else if (std::strcmp(arg, "--filter") == 0 && hasValue) {
+            options.filter = argv[++i];
+        } else {
+            return false;
+        }
+    }
+    int samples = kBlockFrames;
+    while (samples < options.samples) {
+        samples <<= 1;
+    }
+    options.samples = samples;
+    return options.rate > 0;
+}
+
+std::string siblingPath(const char* argv0, const char* name) {
+    const std::string self(argv0);
+    const auto slash = self.find_last_of('/');
+    return slash == std::string::npos ? name : self.substr(0, slash + 1) + name;
+}
+}
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        std::cerr << "usage: " << argv[0]
+                  << " [--rate hz] [--samples n] [--repeats n] [--max-spectral-db db] [--filter text]"
+                     " [--reference disyn_math_check_reference] [--dump out.bin]" << std::endl;
+        return 2;
+    }
+    if (!options.dumpPath.empty()) {
+        return writeDump(options, options.dumpPath) ? 0 : 1;
+    }
+    if (DISYN_MATH == DISYN_MATH_REFERENCE) {
+        std::cerr << "the reference build only writes --dump files; run disyn_math_check" << std::endl;
+        return 2;
+    }
+    if (options.referencePath.empty()) {
+        options.referencePath = siblingPath(argv[0], "disyn_math_check_reference");
+    }
+
+    const std::string dumpPath = (std::filesystem::temp_directory_path() / "disyn_math_check_reference.bin").string();
+    const std::string command = "\"" + options.referencePath + "\" --rate " + std::to_string(options.rate) +
+                                " --samples " + std::to_string(options.samples) + " --repeats " +
+                                std::to_string(options.repeats) + " --dump \"" + dumpPath + "\"";
+    if (std::system(command.c_str()) != 0) {
+        std::cerr << "reference render failed: " << command << std::endl;
+        return 1;
+    }
+    const std::vector<Render> references = readDump(dumpPath);
+    std::remove(dumpPath.c_str());
+    if (references.size() != flues::disyn::kActiveAlgorithmCount) {
+        std::cerr << "reference build has a different algorithm set; build both with the same DISYN_ALGOS"
+                  << std::endl;
+        return 1;
+    }
+
+    const std::size_t perPoint = static_cast<std::size_t>(options.samples);
+    int failures = 0;
+    std::cout << "algorithm,max_error,max_error_db,spectral_diff_db,reference_ms,fast_ms,speedup" << std::endl;
+    for (std::size_t a = 0; a < flues::disyn::kActiveAlgorithmCount; ++a) {
+        const AlgorithmType type = flues::disyn::kActiveAlgorithms[a];
+        const std::string name = flues::disyn::algorithmDescriptor(type).info.name;
+        if (!options.filter.empty() && name.find(options.filter) == std::string::npos) {
+            continue;
+        }
+
+        const Render& reference = references[a];
+        const Render fast = renderAlgorithm(options, type);
+        double maxError = 0.0;
+        double peak = 0.0;
+        for (std::size_t i = 0; i < fast.samples.size(); ++i) {
+            maxError = std::max(maxError, static_cast<double>(std::abs(fast.samples[i] - reference.samples[i])));
+            peak = std::max(peak, static_cast<double>(std::abs(reference.samples[i])));
+        }
+        double worstSpectralDb = -200.0;
+        for (std::size_t point = 0; point < kPointCount; ++point) {
+            for (std::size_t channel = 0; channel < 2; ++channel) {
+                const std::size_t offset = (point * 2 + channel) * perPoint;
+                worstSpectralDb = std::max(worstSpectralDb, spectralDifferenceDb(reference.samples.data() + offset,
+                                                                                 fast.samples.data() + offset,
+                                                                                 perPoint));
+            }
+        }
+        const double errorDb = maxError > 0.0 && peak > 0.0 ? 20.0 * std::log10(maxError / peak) : -200.0;
+        const bool differs = worstSpectralDb > options.maxSpectralDb;
+        const bool failed = differs && !isChaotic(type);
+        failures += failed ? 1 : 0;
+
+        std::cout << name << "," << std::scientific << std::setprecision(2) << maxError << "," << std::fixed
+                  << std::setprecision(1) << errorDb << "," << worstSpectralDb << "," << std::setprecision(2)
+                  << reference.ns / 1.0e6 << "," << fast.ns / 1.0e6 << "," << reference.ns / fast.ns
+                  << (failed ? ",DIFFERS" : differs ? ",CHAOTIC" : "") << std::endl;
+    }
+    return failures > 0 ? 1 : 0;
+}
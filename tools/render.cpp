@@ -0,0 +1,352 @@
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "dsp/DisynEngine.hpp"
+
+// Renders DisynEngine offline from an automation script to a stereo WAV file.
+//
+// Script lines are "<seconds> <name> <value>"; blank lines and text after '#' are ignored.
+// Names: gate (non-zero = note on at the current frequency and velocity, 0 = note off),
+// velocity, frequency, algorithm, param1, param2, param3, fold, attack, release,
+// reverb_size, reverb_level, master, unison (1-8 copies), detune, spread, and end (stop time;
+// the value is ignored). Without an end line the render stops --tail seconds after the last
+// event. Events take effect on the exact frame through the engine's event queue.
+//
+//   disyn_render script.txt -o out.wav [--rate 48000] [--float] [--tail 2]
+//   disyn_render --batch a.txt b.txt ... --out-dir renders [--jobs 8] [--rate ...]
+
+namespace {
+
+using flues::disyn::DisynEngine;
+using flues::disyn::EngineParam;
+
+constexpr int kBlockFrames = DisynEngine::kMaxBlockSize;
+
+struct ScriptEvent {
+    double time;
+    enum class Kind { GATE, VELOCITY, END, PARAM } kind;
+    EngineParam param;
+    float value;
+};
+
+struct Script {
+    std::vector<ScriptEvent> events;
+    bool hasEnd = false;
+    double endTime = 0.0;
+};
+
+struct Options {
+    int rate = 44100;
+    bool floatOutput = false;
+    double tailSeconds = 2.0;
+    int jobs = 0;
+    bool batch = false;
+    std::string outPath;
+    std::string outDir = ".";
+    std::vector<std::string> scripts;
+};
+
+struct RenderStats {
+    long frames = 0;
+    float peak = 0.0f;
+    long nonFinite = 0;
+    long clipped = 0;
+};
+
+bool lookupParam(const std::string& name, EngineParam& param) {
+    static const struct {
+        const char* name;
+        EngineParam param;
+    } kNames[] = {
+        {"algorithm", EngineParam::ALGORITHM},     {"frequency", EngineParam::FREQUENCY},
+        {"param1", EngineParam::PARAM_1},          {"param2", EngineParam::PARAM_2},
+        {"param3", EngineParam::PARAM_3},          {"fold", EngineParam::WAVEFOLD_AMOUNT},
+        {"attack", EngineParam::ATTACK},           {"release", EngineParam::RELEASE},
+        {"reverb_size", EngineParam::REVERB_SIZE}, {"reverb_level", EngineParam::REVERB_LEVEL},
+        {"master", EngineParam::MASTER_GAIN},      {"unison", EngineParam::UNISON_VOICES},
+        {"detune", EngineParam::UNISON_DETUNE},    {"spread", EngineParam::UNISON_SPREAD},
+    };
+    for (const auto& entry : kNames) {
+        if (name == entry.name) {
+            param = entry.param;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool parseScript(const std::string& path, Script& script, std::string& error) {
+    std::ifstream file(path);
+    if (!file) {
+        error = "cannot open " + path;
+        return false;
+    }
+
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(file, line)) {
+        ++lineNumber;
+        line = line.substr(0, line.find('#'));
+        std::istringstream fields(line);
+        double time = 0.0;
+        std::string name;
+        float value = 0.0f;
+        if (!(fields >> time)) {
+            continue;
+        }
+        if (!(fields >> name) || (name != "end" && !(fields >> value)) || time < 0.0) {
+            error = path + ":" + std::to_string(lineNumber) + ": expected <seconds> <name> <value>";
+            return false;
+        }
+
+        ScriptEvent event{time, ScriptEvent::Kind::PARAM, EngineParam::FREQUENCY, value};
+        if (name == "gate") {
+            event.kind = ScriptEvent::Kind::GATE;
+        } else if (name == "velocity") {
+            event.kind = ScriptEvent::Kind::VELOCITY;
+        } else if (name == "end") {
+            script.hasEnd = true;
+            script.endTime = time;
+            continue;
+        } else if (!lookupParam(name, event.param)) {
+            error = path + ":" + std::to_string(lineNumber) + ": unknown name '" + name + "'";
+            return false;
+        }
+        script.events.push_back(event);
+    }
+
+    std::stable_sort(script.events.begin(), script.events.end(),
+                     [](const ScriptEvent& a, const ScriptEvent& b) { return a.time < b.time; });
+    return true;
+}
+
+void writeLe(std::ofstream& file, uint32_t value, int bytes) {
+    for (int i = 0; i < bytes; ++i) {
+        file.put(static_cast<char>((value >> (8 * i)) & 0xFF));
+    }
+}
+
+bool writeWav(const std::string& path, const std::vector<float>& interleaved, int rate, bool floatOutput) {
+    std::ofstream file(path, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+
+    const uint32_t channels = 2;
+    const uint32_t bytesPerSample = floatOutput ? 4 : 2;
+    const uint32_t dataBytes = static_cast<uint32_t>(interleaved.size()) * bytesPerSample;
+    file.write("RIFF", 4);
+    writeLe(file, 36 + dataBytes, 4);
+    file.write("WAVEfmt ", 8);
+    writeLe(file, 16, 4);
+    writeLe(file, floatOutput ? 3 : 1, 2); // IEEE float or PCM
+    writeLe(file, channels, 2);
+    writeLe(file, static_cast<uint32_t>(rate), 4);
+    writeLe(file, static_cast<uint32_t>(rate) * channels * bytesPerSample, 4);
+    writeLe(file, channels * bytesPerSample, 2);
+    writeLe(file, bytesPerSample * 8, 2);
+    file.write("data", 4);
+    writeLe(file, dataBytes, 4);
+
+    for (const float sample : interleaved) {
+        if (floatOutput) {
+            uint32_t bits = 0;
+            std::memcpy(&bits, &sample, sizeof(bits));
+            writeLe(file, bits, 4);
+        } else {
+            const float clamped = std::clamp(sample, -1.0f, 1.0f);
+            const auto pcm = static_cast<int16_t>(std::lround(clamped * 32767.0f));
+            writeLe(file, static_cast<uint16_t>(pcm), 2);
+        }
+    }
+    return static_cast<bool>(file);
+}
+
+// Plays the script through the engine one block at a time, scheduling each event on its frame.
+std::vector<float> render(const Script& script, const Options& options, RenderStats& stats) {
+    DisynEngine engine(static_cast<float>(options.rate));
+    const double lastEvent = script.events.empty() ? 0.0 : script.events.back().time;
+    const double duration = script.hasEnd ? script.endTime : lastEvent + options.tailSeconds;
+    const long totalFrames = static_cast<long>(std::ceil(duration * options.rate));
+
+    std::vector<float> interleaved(static_cast<size_t>(totalFrames) * 2);
+    float left[kBlockFrames];
+    float right[kBlockFrames];
+    float frequency = 440.0f;
+    float velocity = 1.0f;
+    size_t next = 0;
+
+    for (long start = 0; start < totalFrames;) {
+        int frames = static_cast<int>(std::min<long>(kBlockFrames, totalFrames - start));
+        // The engine queues a limited number of events per call; shorten the block when full.
+        int queued = 0;
+        while (next < script.events.size()) {
+            const ScriptEvent& event = script.events[next];
+            const long frame = std::lround(event.time * options.rate);
+            if (frame >= start + frames) {
+                break;
+            }
+            if (queued == DisynEngine::kMaxEvents) {
+                frames = static_cast<int>(std::max<long>(1, frame - start));
+                break;
+            }
+
+            const int offset = static_cast<int>(std::max<long>(0, frame - start));
+            switch (event.kind) {
+                case ScriptEvent::Kind::GATE:
+                    if (event.value != 0.0f) {
+                        engine.scheduleNoteOn(offset, frequency, velocity);
+                    } else {
+                        engine.scheduleNoteOff(offset);
+                    }
+                    break;
+                case ScriptEvent::Kind::VELOCITY:
+                    velocity = event.value;
+                    break;
+                case ScriptEvent::Kind::PARAM:
+                    if (event.param == EngineParam::FREQUENCY) {
+                        frequency = event.value;
+                    }
+                    engine.scheduleParameter(offset, event.param, event.value);
+                    break;
+                default:
+                    break;
+            }
+            ++queued;
+            ++next;
+        }
+
+        engine.processBlock(left, right, frames);
+        for (int i = 0; i < frames; ++i) {
+            for (const float sample : {left[i], right[i]}) {
+                if (!std::isfinite(sample)) {
+                    ++stats.nonFinite;
+                } else {
+                    stats.peak = std::max(stats.peak, std::abs(sample));
+                    stats.clipped += std::abs(sample) > 1.0f ? 1 : 0;
+                }
+            }
+            interleaved[static_cast<size_t>(start + i) * 2] = left[i];
+            interleaved[static_cast<size_t>(start + i) * 2 + 1] = right[i];
+        }
+        start += frames;
+    }
+    stats.frames = totalFrames;
+    return interleaved;
+}
+
+std::string outputPathFor(const Options& options, const std::string& scriptPath) {
+    if (!options.batch) {
+        return options.outPath;
+    }
+    std::string stem = scriptPath.substr(scriptPath.find_last_of("/\\") + 1);
+    stem = stem.substr(0, stem.find_last_of('.'));
+    return options.outDir + "/" + stem + ".wav";
+}
+
+// Returns a one-line report; ok is false when the script or the output file fails.
+std::string renderScript(const Options& options, const std::string& scriptPath, bool& ok) {
+    Script script;
+    std::string error;
+    if (!parseScript(scriptPath, script, error)) {
+        ok = false;
+        return error;
+    }
+
+    RenderStats stats;
+    const std::vector<float> audio = render(script, options, stats);
+    const std::string outPath = outputPathFor(options, scriptPath);
+    if (!writeWav(outPath, audio, options.rate, options.floatOutput)) {
+        ok = false;
+        return "cannot write " + outPath;
+    }
+
+    ok = true;
+    std::ostringstream report;
+    report << outPath << ": " << stats.frames << " frames, peak " << stats.peak << ", clipped " << stats.clipped
+           << ", non-finite " << stats.nonFinite;
+    return report.str();
+}
+
+bool parseOptions(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (std::strcmp(arg, "-o") == 0 && hasValue) {
+            options.outPath = argv[++i];
+        } else if (std::strcmp(arg, "--rate") == 0 && hasValue) {
+            options.rate = std::atoi(argv[++i]);
+        } else if (std::strcmp(arg, "--float") == 0) {
+            options.floatOutput = true;
+        } else if (std::strcmp(arg, "--tail") == 0 && hasValue) {
+            options.tailSeconds = std::atof(argv[++i]);
+        } else if (std::strcmp(arg, "--batch") == 0) {
+            options.batch = true;
+        } else if (std::strcmp(arg, "--out-dir") == 0 && hasValue) {
+            options.outDir = argv[++i];
+        } else if (std::strcmp(arg, "--jobs") == 0 && hasValue) {
+            options.jobs = std::atoi(argv[++i]);
+        } else if (arg[0] == '-') {
+            return false;
+        } else {
+            options.scripts.push_back(arg);
+        }
+    }
+    if (options.rate <= 0 || options.scripts.empty()) {
+        return false;
+    }
+    return options.batch || (options.scripts.size() == 1 && !options.outPath.empty());
+}
+}
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        std::cerr << "usage: " << argv[0] << " script.txt -o out.wav [--rate hz] [--float] [--tail seconds]\n"
+                  << "       " << argv[0]
+                  << " --batch script.txt... [--out-dir dir] [--jobs n] [--rate hz] [--float] [--tail seconds]"
+                  << std::endl;
+        return 2;
+    }
+
+    // Each script renders on its own engine, so scripts are spread across worker threads.
+    const int hardware = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    const int jobs = std::clamp(options.jobs > 0 ? options.jobs : hardware, 1,
+                                static_cast<int>(options.scripts.size()));
+    std::vector<std::string> reports(options.scripts.size());
+    std::vector<char> succeeded(options.scripts.size(), 0);
+    std::atomic<size_t> nextScript{0};
+
+    const auto worker = [&]() {
+        for (size_t index = nextScript++; index < options.scripts.size(); index = nextScript++) {
+            bool ok = false;
+            reports[index] = renderScript(options, options.scripts[index], ok);
+            succeeded[index] = ok ? 1 : 0;
+        }
+    };
+    std::vector<std::thread> threads;
+    for (int i = 1; i < jobs; ++i) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    int failures = 0;
+    for (size_t i = 0; i < reports.size(); ++i) {
+        (succeeded[i] ? std::cout : std::cerr) << reports[i] << std::endl;
+        failures += succeeded[i] ? 0 : 1;
+    }
+    return failures > 0 ? 1 : 0;
+}
@@ -0,0 +1,51 @@
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+
+#include "dsp/algorithms/AlgorithmUtils.hpp"
+
+namespace {
+struct ErrorStats {
+    double maxError = 0.0;
+    double maxErrorAt = 0.0;
+    double rmsError = 0.0;
+};
+
+template <typename Approximation>
+ErrorStats sweep(Approximation approximation, float minInput, float maxInput, int steps) {
+    ErrorStats stats;
+    double sumSq = 0.0;
+    for (int i = 0; i <= steps; ++i) {
+        const float x = minInput + (maxInput - minInput) * static_cast<float>(i) / static_cast<float>(steps);
+        const double error = std::abs(static_cast<double>(approximation(x)) - std::tanh(static_cast<double>(x)));
+        sumSq += error * error;
+        if (error > stats.maxError) {
+            stats.maxError = error;
+            stats.maxErrorAt = x;
+        }
+    }
+    stats.rmsError = std::sqrt(sumSq / static_cast<double>(steps + 1));
+    return stats;
+}
+}
+
+int main() {
+    const float minInput = -8.0f;
+    const float maxInput = 8.0f;
+    const int steps = 1600000;
+
+    const ErrorStats reference = sweep([](float x) { return std::tanh(x); }, minInput, maxInput, steps);
+    const ErrorStats fast = sweep([](float x) { return flues::disyn::fastTanh(x); }, minInput, maxInput, steps);
+
+    std::cout << "function,max_error,max_error_at,rms_error" << std::endl;
+    std::cout << std::scientific << std::setprecision(3)
+              << "std::tanh," << reference.maxError << "," << reference.maxErrorAt << "," << reference.rmsError << std::endl
+              << "fastTanh," << fast.maxError << "," << fast.maxErrorAt << "," << fast.rmsError << std::endl;
+
+    if (fast.maxError > flues::disyn::FAST_TANH_MAX_ERROR) {
+        std::cout << "FAIL: fastTanh max error exceeds " << flues::disyn::FAST_TANH_MAX_ERROR << std::endl;
+        return 1;
+    }
+    return 0;
+}
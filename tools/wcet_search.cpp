@@ -0,0 +1,275 @@
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+
+#include "dsp/DisynEngine.hpp"
+#include "dsp/algorithms/AlgorithmRegistry.hpp"
+
+#include "HostCpu.hpp"
+
+// Searches pitch, param1..3 and gate/parameter edges for the slowest 64-frame
+// DisynEngine::processBlock per algorithm, and reports it against the real-time deadline.
+// Each candidate settles a held note, then applies its edge and times the next few blocks.
+// Every block is timed on several copies of the same engine state and the fastest copy is
+// kept, so one block's cost is measured without scheduler noise. Random sampling is
+// followed by a shrinking local search around the slowest candidate found so far.
+
+namespace {
+
+using flues::disyn::AlgorithmType;
+using flues::disyn::DisynEngine;
+
+constexpr int kBlockFrames = 64;
+constexpr int kSettleBlocks = 8;
+constexpr int kTimedBlocks = 4;
+constexpr float kPitchMin = 30.0f;   // Parameters::pitchMin
+constexpr float kPitchMax = 4000.0f; // Parameters::pitchMax
+
+enum class Edge {
+    HOLD,        // steady state, note held
+    RETRIGGER,   // noteOn while playing: full reset path
+    NOTE_FROM_IDLE,
+    PARAM_JUMP,  // all params move to the opposite end of their range
+    RELEASE,
+    COUNT
+};
+
+const char* edgeName(Edge edge) {
+    switch (edge) {
+        case Edge::HOLD:
+            return "hold";
+        case Edge::RETRIGGER:
+            return "retrigger";
+        case Edge::NOTE_FROM_IDLE:
+            return "note_from_idle";
+        case Edge::PARAM_JUMP:
+            return "param_jump";
+        case Edge::RELEASE:
+            return "release";
+        default:
+            return "?";
+    }
+}
+
+struct Candidate {
+    float pitch = 440.0f;
+    float p1 = 0.5f;
+    float p2 = 0.5f;
+    float p3 = 0.5f;
+    Edge edge = Edge::HOLD;
+};
+
+struct Options {
+    int rate = 44100;
+    int samples = 150;
+    int refineSteps = 80;
+    int repeats = 5;
+    unsigned seed = 1;
+    std::string filter;
+    double hostMhz = 0.0;
+    double esp32Scale = 1.0;
+};
+
+volatile float sink = 0.0f;
+
+void applyParams(DisynEngine& engine, const Candidate& candidate, bool mirrored) {
+    const auto mirror = [mirrored](float value) { return mirrored ? 1.0f - value : value; };
+    engine.setParam1(mirror(candidate.p1));
+    engine.setParam2(mirror(candidate.p2));
+    engine.setParam3(mirror(candidate.p3));
+}
+
+// Fastest of repeats runs of one block, each on a fresh copy of the same engine state.
+double timeBlock(const DisynEngine& state, int repeats) {
+    std::array<float, kBlockFrames> left{};
+    std::array<float, kBlockFrames> right{};
+    double best = 0.0;
+    for (int r = 0; r < repeats; ++r) {
+        DisynEngine engine = state;
+        const auto start = std::chrono::steady_clock::now();
+        engine.processBlock(left.data(), right.data(), kBlockFrames);
+        const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+        sink = sink + left[0] + right[kBlockFrames - 1];
+        best = r == 0 ? elapsed.count() : std::min(best, elapsed.count());
+    }
+    return best;
+}
+
+// Worst block time in ns over the blocks following the candidate's edge.
+double measure(const Options& options, AlgorithmType type, const Candidate& candidate) {
+    DisynEngine engine(static_cast<float>(options.rate));
+    std::array<float, kBlockFrames> left{};
+    std::array<float, kBlockFrames> right{};
+
+    engine.setAlgorithm(static_cast<int>(type));
+    engine.setWavefoldAmount(0.5f);
+    engine.setReverbLevel(0.3f);
+    applyParams(engine, candidate, candidate.edge == Edge::PARAM_JUMP);
+    if (candidate.edge != Edge::NOTE_FROM_IDLE) {
+        engine.noteOn(candidate.pitch, 1.0f);
+    }
+    for (int block = 0; block < kSettleBlocks; ++block) {
+        engine.processBlock(left.data(), right.data(), kBlockFrames);
+    }
+
+    switch (candidate.edge) {
+        case Edge::RETRIGGER:
+        case Edge::NOTE_FROM_IDLE:
+            engine.scheduleNoteOn(0, candidate.pitch, 1.0f);
+            break;
+        case Edge::PARAM_JUMP:
+            applyParams(engine, candidate, false);
+            break;
+        case Edge::RELEASE:
+            engine.scheduleNoteOff(0);
+            break;
+        default:
+            break;
+    }
+
+    double worst = 0.0;
+    for (int block = 0; block < kTimedBlocks; ++block) {
+        worst = std::max(worst, timeBlock(engine, options.repeats));
+        engine.processBlock(left.data(), right.data(), kBlockFrames);
+    }
+    return worst;
+}
+
+Candidate randomCandidate(std::mt19937& rng) {
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    std::uniform_int_distribution<int> edge(0, static_cast<int>(Edge::COUNT) - 1);
+    Candidate candidate;
+    // Log-uniform across the firmware's pitch range.
+    candidate.pitch = kPitchMin * std::pow(kPitchMax / kPitchMin, unit(rng));
+    candidate.p1 = unit(rng);
+    candidate.p2 = unit(rng);
+    candidate.p3 = unit(rng);
+    candidate.edge = static_cast<Edge>(edge(rng));
+    return candidate;
+}
+
+Candidate perturb(const Candidate& base, float scale, std::mt19937& rng) {
+    std::normal_distribution<float> step(0.0f, scale);
+    Candidate candidate = base;
+    candidate.pitch = std::clamp(base.pitch * std::pow(kPitchMax / kPitchMin, step(rng)), kPitchMin, kPitchMax);
+    candidate.p1 = std::clamp(base.p1 + step(rng), 0.0f, 1.0f);
+    candidate.p2 = std::clamp(base.p2 + step(rng), 0.0f, 1.0f);
+    candidate.p3 = std::clamp(base.p3 + step(rng), 0.0f, 1.0f);
+    return candidate;
+}
+
+struct SearchResult {
+    Candidate candidate;
+    double worstNs = 0.0;
+};
+
+SearchResult search(const Options& options, AlgorithmType type) {
+    std::mt19937 rng(options.seed + static_cast<unsigned>(type));
+    SearchResult best;
+
+    // Parameter extremes first: cost usually peaks at the end of a range.
+    for (const float p : {0.0f, 1.0f}) {
+        for (int edge = 0; edge < static_cast<int>(Edge::COUNT); ++edge) {
+            for (const float pitch : {kPitchMin, kPitchMax}) {
+                const Candidate candidate{pitch, p, p, p, static_cast<Edge>(edge)};
+                const double ns = measure(options, type, candidate);
+                if (ns > best.worstNs) {
+                    best = {candidate, ns};
+                }
+            }
+        }
+    }
+
+    for (int i = 0; i < options.samples; ++i) {
+        const Candidate candidate = randomCandidate(rng);
+        const double ns = measure(options, type, candidate);
+        if (ns > best.worstNs) {
+            best = {candidate, ns};
+        }
+    }
+
+    float scale = 0.2f;
+    for (int i = 0; i < options.refineSteps; ++i) {
+        const Candidate candidate = perturb(best.candidate, scale, rng);
+        const double ns = measure(options, type, candidate);
+        if (ns > best.worstNs) {
+            best = {candidate, ns};
+        } else {
+            scale = std::max(0.01f, scale * 0.97f);
+        }
+    }
+    return best;
+}
+
+bool parseOptions(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (std::strcmp(arg, "--rate") == 0 && hasValue) {
+            options.rate = std::atoi(argv[++i]);
+        } else if (std::strcmp(arg, "--samples") == 0 && hasValue) {
+            options.samples = std::max(0, std::atoi(argv[++i]));
+        } else if (std::strcmp(arg, "--refine") == 0 && hasValue) {
+            options.refineSteps = std::max(0, std::atoi(argv[++i]));
+        } else if (std::strcmp(arg, "--repeats") == 0 && hasValue) {
+            options.repeats = std::max(1, std::atoi(argv[++i]));
+        } else if (std::strcmp(arg, "--seed") == 0 && hasValue) {
+            options.seed = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(arg, "--filter") == 0 && hasValue) {
+            options.filter = argv[++i];
+        } else if (std::strcmp(arg, "--host-mhz") == 0 && hasValue) {
+            options.hostMhz = std::atof(argv[++i]);
+        } else if (std::strcmp(arg, "--esp32-scale") == 0 && hasValue) {
+            options.esp32Scale = std::atof(argv[++i]);
+        } else {
+            return false;
+        }
+    }
+    return options.rate > 0;
+}
+}
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        std::cerr << "usage: " << argv[0]
+                  << " [--rate hz] [--samples n] [--refine n] [--repeats n] [--seed n] [--filter text]"
+                     " [--host-mhz mhz] [--esp32-scale factor]" << std::endl;
+        return 2;
+    }
+    if (options.hostMhz <= 0.0) {
+        options.hostMhz = disyn::tools::detectHostMhz();
+    }
+
+    const double deadlineUs = 1.0e6 * kBlockFrames / options.rate;
+    int overruns = 0;
+    std::cout << "algorithm,host_worst_us,esp32_est_us,deadline_us,esp32_deadline_percent,pitch,param1,param2,param3,edge"
+              << std::endl;
+    for (const AlgorithmType type : flues::disyn::kActiveAlgorithms) {
+        const std::string name = flues::disyn::algorithmDescriptor(type).info.name;
+        if (!options.filter.empty() && name.find(options.filter) == std::string::npos) {
+            continue;
+        }
+
+        const SearchResult result = search(options, type);
+        const double hostUs = result.worstNs / 1000.0;
+        const double esp32Us =
+            disyn::tools::esp32Cycles(result.worstNs, options.hostMhz, options.esp32Scale) / disyn::tools::kEsp32Hz * 1.0e6;
+        const double percent = 100.0 * esp32Us / deadlineUs;
+        overruns += percent > 100.0 ? 1 : 0;
+
+        const Candidate& worst = result.candidate;
+        std::cout << name << "," << std::fixed << std::setprecision(2) << hostUs << "," << esp32Us << ","
+                  << deadlineUs << "," << percent << "," << std::setprecision(1) << worst.pitch << ","
+                  << std::setprecision(3) << worst.p1 << "," << worst.p2 << "," << worst.p3 << ","
+                  << edgeName(worst.edge) << (percent > 100.0 ? ",OVERRUN" : "") << std::endl;
+    }
+    return overruns > 0 ? 1 : 0;
+}